@@ -55,6 +55,7 @@
 #include <wx/spinctrl.h>
 #include <wx/aui/aui.h>
 #include <wx/event.h>
+#include <wx/thread.h>
 #include <wx/fontpicker.h>
 #include "wx/json_defs.h"
 #include "wx/jsonreader.h"
@@ -68,16 +69,22 @@
 // Differs from the built-in plugins, so that we can build outside of OpenCPN source tree
 #include "ocpn_plugin.h"
 
-// NMEA0183 Sentence parsing functions
-#include "nmea0183.h"
-
 // Dashboard instruments/dials/gauges
 #include "instrument.h"
 #include "speedometer.h"
 #include "rudder_angle.h"
 
-typedef unsigned char byte;
+// NMEA 0183, NMEA 2000 & SignalK decoders
+#include "decoder.h"
+
+// Lock free queues between the UI thread and the decode thread
+#include "spsc_queue.h"
+// Routing and dispatch of the values through the queues to the instruments
+#include "value_dispatch.h"
+#include <atomic>
+#include <vector>
 
+class dashboard_pi;
 class DashboardWindow;
 class DashboardWindowContainer;
 class DashboardInstrumentContainer;
@@ -88,25 +95,43 @@ class DashboardInstrumentContainer;
 // If no data received in 5 seconds, zero the instrument displays
 #define WATCHDOG_TIMEOUT_COUNT  5
 
-// Kelvin to celsius
-#define CONST_KELVIN 273.15
-#define CONVERT_KELVIN(x) ((x) - CONST_KELVIN )
-
-// RADIANS/DEGREES
-#define RADIANS_TO_DEGREES(x) ((x) * 180 / M_PI)
+// Interval (milliseconds) of the refresh scheduler, and the estimated paint time
+// (milliseconds) that may be scheduled in each interval
+#define SCHEDULER_INTERVAL 50
+#define REFRESH_BUDGET 10
+
+// Frame budget governor. The default budget (milliseconds of painting per scheduler interval),
+// zero disables the governor. Quality is stepped down a level once the frame time has exceeded
+// the budget for GOVERNOR_DOWN_TICKS consecutive intervals, and restored a level once it has been
+// below GOVERNOR_HEADROOM of the budget for GOVERNOR_UP_TICKS, so that it does not oscillate.
+#define DEFAULT_FRAME_BUDGET 10
+#define GOVERNOR_DOWN_TICKS 4
+#define GOVERNOR_UP_TICKS 40
+#define GOVERNOR_HEADROOM 0.5
+
+// Capacity of the queues between the UI thread and the decode thread (must be a power of two)
+#define INGEST_QUEUE_SIZE 256
+#define DECODED_QUEUE_SIZE 1024
+// Id of the thread event posted when the decoders first see a second engine instance
+#define DECODE_EVENT_DUAL_ENGINE 1
+
+// How often (in seconds) diagnostics are written to the log, if enabled
+#define DIAGNOSTICS_INTERVAL 60
 
 wxString iconFolder;
 
 class DashboardWindowContainer {
 public:
 	DashboardWindowContainer(DashboardWindow *dashboard_window, wxString name, wxString caption, wxString orientation, wxArrayInt inst) {
-       m_pDashboardWindow = dashboard_window; m_sName = name; m_sCaption = caption; m_sOrientation = orientation; m_aInstrumentList = inst; m_bIsVisible = false; m_bIsDeleted = false; }
+       m_pDashboardWindow = dashboard_window; m_sName = name; m_sCaption = caption; m_sOrientation = orientation; m_aInstrumentList = inst; m_bIsVisible = false; m_bIsDeleted = false; m_bSuspended = true; }
 
 	~DashboardWindowContainer(){}
 
 	DashboardWindow *m_pDashboardWindow;
 	bool m_bIsVisible;
 	bool m_bIsDeleted;
+	// Not receiving values whilst hidden, the latest values are replayed when shown
+	bool m_bSuspended;
 	// Persists visibility, even when Dashboard tool is toggled off.
 	bool m_bPersVisible;  
 	wxString m_sName;
@@ -118,13 +143,28 @@ public:
 class DashboardInstrumentContainer {
 public:
 	DashboardInstrumentContainer(int id, DashboardInstrument *instrument, CapType capa) {
-		m_ID = id; m_pInstrument = instrument; m_cap_flag = capa; }
+		m_ID = id; m_pInstrument = instrument; m_cap_flag = capa; m_cell = NULL; }
 
 	~DashboardInstrumentContainer(){ delete m_pInstrument; }
 
 	DashboardInstrument *m_pInstrument;
 	int m_ID;
 	CapType m_cap_flag;
+	// Sizer item reserving the instrument's space, when composited
+	wxSizerItem *m_cell;
+};
+
+// Drains the ingest queue, parsing each payload off the UI thread
+class DashboardDecodeThread : public wxThread {
+public:
+	DashboardDecodeThread(dashboard_pi *plugin) : wxThread(wxTHREAD_JOINABLE) { m_plugin = plugin; }
+	~DashboardDecodeThread() {}
+
+protected:
+	void *Entry();
+
+private:
+	dashboard_pi *m_plugin;
 };
 
 // Dynamic arrays of pointers need explicit macros in wx261
@@ -141,7 +181,7 @@ WX_DEFINE_ARRAY(DashboardInstrumentContainer *, wxArrayOfInstrument);
 // Engine Dashboard PlugIn Class Definition
 //
 
-class dashboard_pi : public opencpn_plugin_118, wxTimer {
+class dashboard_pi : public opencpn_plugin_118, wxTimer, public DecoderListener {
 public:
 	dashboard_pi(void *ppimgr);
 	~dashboard_pi(void);
@@ -175,18 +215,73 @@ public:
 	int GetToolbarItemId();
 	int GetDashboardWindowShownCount();
 	void SetPluginMessage(wxString& message_id, wxString& message_body);
+
+	// Decode thread statistics
+	size_t GetIngestQueueDepth() { return m_ingestQueue.GetDepth(); }
+	unsigned long GetIngestDropCount() { return m_ingestQueue.GetDropped(); }
+	size_t GetDecodedQueueDepth() { return m_decodedQueue.GetDepth(); }
+	unsigned long GetDecodedDropCount() { return m_decodedQueue.GetDropped(); }
 	  
 private:
+	friend class DashboardDecodeThread;
+
 	// Load plugin configuraton
 	bool LoadConfig(void);
 	void ApplyConfig(void);
 	// Send deconstructed NMEA 1083 sentence values to each display
+	// When invoked from the decode thread, the value is queued for the UI thread
 	void SendSentenceToAllInstruments(DASH_CAP st, double value, wxString unit);
-	// Conversion utilities
-	double Celsius2Fahrenheit(double temperature);
-	double Fahrenheit2Celsius(double temperature);
-	double Pascal2Psi(double pressure);
-	double Psi2Pascal(double pressure);
+	// Send all of the values decoded from a message to each display
+	void SendBatchToAllInstruments(const DashboardBatch &batch);
+	// Record that this is a dual engine vessel, on the UI thread
+	void OnDualEngineDetected(void);
+	// Send a value to each display, only invoked on the UI thread
+	void DispatchToAllInstruments(DASH_CAP st, double value, const wxString &unit);
+	void DispatchToAllInstruments(const DecodedValue *values, size_t count);
+
+	// Hidden dashboards are suspended, they neither format values nor paint.
+	// The latest value of each channel is kept, to bring a dashboard up to date when shown.
+	LatestValues m_latestValues;
+	std::vector<DecodedValue> m_replayValues;
+	bool IsReceiving(DashboardWindowContainer *cont);
+
+	// Decode thread, queues and signalling
+	DashboardDecodeThread *m_pDecodeThread;
+	SpscQueue<IngestItem, INGEST_QUEUE_SIZE> m_ingestQueue;
+	SpscQueue<DecodedValue, DECODED_QUEUE_SIZE> m_decodedQueue;
+	wxSemaphore m_ingestSignal;
+	std::atomic<bool> m_decoderIdle;
+	std::atomic<bool> m_decoderExit;
+	std::atomic<bool> m_decodedPending;
+	bool StartDecodeThread(void);
+	void StopDecodeThread(void);
+	void Enqueue(IngestType type, const wxString &sentence);
+	void Enqueue(IngestType type, const std::vector<uint8_t> &payload);
+	void DecodeIngestQueue(void);
+	void OnDecodedValues(wxThreadEvent &event);
+
+	// Parses the payloads, only used by the decode thread
+	DashboardDecoder m_decoder;
+	// Copy the preferences used by the decoder, whenever they are loaded or changed
+	void PublishDecoderSettings(void);
+
+	// Refresh each instrument at its own rate, within the refresh budget
+	size_t m_scheduleCursor;
+	std::vector<DashboardInstrument *> m_instrumentOrder;
+	wxLongLong m_lastWatchDogCheck;
+	void ScheduleRefresh(void);
+
+	// Steps the render quality down under load, and back up when there is headroom
+	double m_frameBudget;
+	double m_frameTime;
+	int m_overBudgetTicks;
+	int m_underBudgetTicks;
+	void GovernQuality(void);
+
+	// Periodically log the statistics
+	bool m_diagnostics;
+	int m_diagnosticsTick;
+	void LogDiagnostics(void);
 
 	// OpenCPN goodness, pointers to Configuration, AUI Manager and Toolbar
 	wxFileConfig *m_pconfig;
@@ -198,19 +293,8 @@ private:
 	int m_show_id;
 	int m_hide_id;
 
-	// Used to parse JSON values from SignalK
-	wxJSONValue root;
-	wxJSONReader jsonReader;
-	wxString self;
-	void HandleSKUpdate(wxJSONValue &update);
-	void UpdateSKItem(wxJSONValue &item);
-	double GetJsonDouble(wxJSONValue &value); // FFS
-	bool CheckAlarmState(wxJSONValue& value);
-
-	// Used to parse NMEA Sentences
-	NMEA0183 m_NMEA0183;
-
 	// Initialize NMEA 183 Listeners
+	// The Handle methods run on the UI thread and queue the payload for the decoder
 	void HandleXDR(ObservedEvt ev);
 	std::shared_ptr<ObservableListener> listener_xdr;
 
@@ -226,10 +310,6 @@ private:
 
 
 	// NMEA 2000
-	// index into the payload.
-	// The payload is in Actisense format, so as I've just pasted code from twocan, this simplifies 
-	// accessing the data
-	const int index = 13;
 	// Engine Parameters - Rapid Update
 	void HandleN2K_127488(ObservedEvt ev);
 	std::shared_ptr<ObservableListener> listener_127488;
@@ -249,117 +329,10 @@ private:
 	void HandleN2K_127245(ObservedEvt ev);
 	std::shared_ptr<ObservableListener> listener_127245;
 
-	// NMEA 2000 Data Validation
-	template<typename T>
-	static bool IsDataValid(T value);
-
-	static bool IsDataValid(byte value) {
-		if ((value == UCHAR_MAX) || (value == UCHAR_MAX - 1) || (value == UCHAR_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(char value) {
-		if ((value == CHAR_MAX) || (value == CHAR_MAX - 1) || (value == CHAR_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(unsigned short value) {
-		if ((value == USHRT_MAX) || (value == USHRT_MAX - 1) || (value == USHRT_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(short value) {
-		if ((value == SHRT_MAX) || (value == SHRT_MAX - 1) || (value == SHRT_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(unsigned int value) {
-		if ((value == UINT_MAX) || (value == UINT_MAX - 1) || (value == UINT_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(int value) {
-		if ((value == INT_MAX) || (value == INT_MAX - 1) || (value == INT_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(unsigned long value) {
-		if ((value == ULONG_MAX) || (value == ULONG_MAX - 1) || (value == ULONG_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(long value) {
-		if ((value == LONG_MAX) || (value == LONG_MAX - 1) || (value == LONG_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(unsigned long long value) {
-		if ((value == ULLONG_MAX) || (value == ULLONG_MAX - 1) || (value == ULLONG_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-	static bool IsDataValid(long long value) {
-		if ((value == LLONG_MAX) || (value == LLONG_MAX - 1) || (value == LLONG_MAX - 2)) {
-			return FALSE;
-		}
-		else {
-			return TRUE;
-		}
-	}
-
-
-
-
 	// For some reason in older dashboard implementations used this variable was used to differentiate config file versions
 	// Engine Dashboard uses version 2 configuration settings
 	int m_config_version;
 
-	// Watchdog timer, performs two functions, firstly refresh the dashboard every second,  
-	// and secondly, if no data is received, set instruments to zero (eg. Engine switched off)
-	wxDateTime engineWatchDog;
-	wxDateTime tankLevelWatchDog;
-
-	// Store the current engine hours for displaying in the Tachometer Dial
-	double mainEngineHours;
-	double portEngineHours;
-	double stbdEngineHours;
-
 };
 
 class DashboardPreferencesDialog : public wxDialog {
@@ -437,16 +410,6 @@ enum {
 	ID_DASH_UNDOCK
 };
 
-enum {
-	PRESSURE_BAR,
-	PRESSURE_PSI
-};
-
-enum {
-	TEMPERATURE_CELSIUS,
-	TEMPERATURE_FAHRENHEIT
-};
-
 class DashboardWindow : public wxWindow {
 public:
 	DashboardWindow(wxWindow *pparent, wxWindowID id, wxAuiManager *auimgr, dashboard_pi* plugin,
@@ -462,7 +425,17 @@ public:
     bool isInstrumentListEqual(const wxArrayInt& list);
     void SetInstrumentList(wxArrayInt list);
     void SendSentenceToAllInstruments(DASH_CAP st, double value, wxString unit);
+    void SendBatchToAllInstruments(const DecodedValue *values, size_t count);
     void ChangePaneOrientation(int orient, bool updateAUImgr);
+    size_t GetInstrumentCount() { return m_ArrayOfInstrument.GetCount(); }
+    DashboardInstrument *GetInstrument(size_t i) { return m_ArrayOfInstrument.Item(i)->m_pInstrument; }
+    void OnAnimationTimer(wxTimerEvent& evt);
+    void RestartAnimationTimer(void);
+    // Composited rendering, every instrument is painted into one back-buffer
+    bool IsComposite() { return m_composite; }
+    double GetFrameCost() { return m_frameCost; }
+    void OnPaint(wxPaintEvent& evt);
+    void OnEraseBackground(wxEraseEvent& evt);
 
 	// TODO: OnKeyPress pass event to main window or disable focus
 
@@ -473,6 +446,12 @@ private:
 	dashboard_pi *m_plugin;
 	wxBoxSizer *itemBoxSizer;
 	wxArrayOfInstrument m_ArrayOfInstrument;
+	// Only runs whilst a needle is moving
+	wxTimer m_animationTimer;
+	bool m_composite;
+	wxBitmap m_backBuffer;
+	double m_frameCost;
+	void LayoutCells(void);
 };
 
 #endif
@@ -0,0 +1,306 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Decodes NMEA 0183 XDR, RPM & RSA sentences, NMEA 2000 engine, fluid level, battery, temperature
+// & rudder PGNs and SignalK updates into instrument values. Runs on the decode thread and has no
+// dependency on OpenCPN, so the decoders may also be driven by the allocation budget test.
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _DECODER_H_
+#define _DECODER_H_
+
+#include <wx/wxprec.h>
+
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#include "wx/json_defs.h"
+#include "wx/jsonreader.h"
+#include "wx/jsonval.h"
+
+// NMEA0183 Sentence parsing functions
+#include "nmea0183.h"
+
+// Dashboard Capability Enums
+#include "instrument.h"
+
+#include <atomic>
+#include <climits>
+#include <vector>
+
+typedef unsigned char byte;
+
+// Kelvin to celsius
+#define CONST_KELVIN 273.15
+#define CONVERT_KELVIN(x) ((x) - CONST_KELVIN )
+
+// RADIANS/DEGREES
+#define RADIANS_TO_DEGREES(x) ((x) * 180 / M_PI)
+
+// Maximum number of values decoded from a single message
+#define MAX_BATCH_VALUES 8
+
+enum {
+	PRESSURE_BAR,
+	PRESSURE_PSI
+};
+
+enum {
+	TEMPERATURE_CELSIUS,
+	TEMPERATURE_FAHRENHEIT
+};
+
+// Raw payloads received by the event handlers on the UI thread, waiting to be decoded
+typedef enum {
+	INGEST_NMEA0183_XDR,
+	INGEST_NMEA0183_RPM,
+	INGEST_NMEA0183_RSA,
+	INGEST_N2K_127488,
+	INGEST_N2K_127489,
+	INGEST_N2K_127505,
+	INGEST_N2K_127508,
+	INGEST_N2K_130312,
+	INGEST_N2K_127245,
+	INGEST_SIGNALK
+} IngestType;
+
+struct IngestItem {
+	IngestType type;
+	wxString sentence;
+	std::vector<uint8_t> payload;
+};
+
+// The preferences used by the decoder. It takes a copy before each payload, so that
+// it never reads the globals which the preferences dialog writes on the UI thread.
+struct DecoderSettings {
+	int temperatureUnit;
+	int pressureUnit;
+	bool dualEngine;
+};
+
+// Values produced by the decode thread, waiting to be sent to the instruments
+struct DecodedValue {
+	DASH_CAP cap;
+	double value;
+	wxString unit;
+};
+
+// Values decoded from a single message, sent to the instruments in one pass
+class DashboardBatch {
+public:
+	DashboardBatch() : m_count(0) {}
+	void Add(DASH_CAP cap, double value, const wxString &unit) {
+		if (m_count < MAX_BATCH_VALUES) {
+			m_values[m_count].cap = cap;
+			m_values[m_count].value = value;
+			m_values[m_count].unit = unit;
+			m_count++;
+		}
+	}
+	const DecodedValue *GetValues(void) const { return m_values; }
+	size_t GetCount(void) const { return m_count; }
+
+private:
+	DecodedValue m_values[MAX_BATCH_VALUES];
+	size_t m_count;
+};
+
+// Receives the values decoded from each payload
+class DecoderListener {
+public:
+	virtual ~DecoderListener() {}
+	// A single value, or all of the values decoded from a message
+	virtual void SendSentenceToAllInstruments(DASH_CAP st, double value, wxString unit) = 0;
+	virtual void SendBatchToAllInstruments(const DashboardBatch &batch) = 0;
+	// A second engine instance has been received, the vessel was not configured as dual engine
+	virtual void OnDualEngineDetected(void) = 0;
+};
+
+class DashboardDecoder {
+public:
+	DashboardDecoder(DecoderListener *listener);
+
+	// Invoked by the UI thread whenever the preferences used by the decoder are loaded or changed
+	void PublishSettings(const DecoderSettings &settings);
+	// Parse a payload, and send the values to the listener
+	void DecodeItem(IngestItem &item);
+
+	// Watchdog timers, time (in seconds) of the last engine and tank data received,
+	// read by the UI thread to zero the instruments (eg. Engine switched off)
+	std::atomic<long> engineWatchDog;
+	std::atomic<long> tankLevelWatchDog;
+
+private:
+	DecoderListener *m_listener;
+	void SendSentenceToAllInstruments(DASH_CAP st, double value, wxString unit) { m_listener->SendSentenceToAllInstruments(st, value, unit); }
+	void SendBatchToAllInstruments(const DashboardBatch &batch) { m_listener->SendBatchToAllInstruments(batch); }
+
+	// Preferences published by the UI thread, and the decoder's copy of them
+	std::atomic<int> m_publishedTemperatureUnit;
+	std::atomic<int> m_publishedPressureUnit;
+	std::atomic<bool> m_publishedDualEngine;
+	DecoderSettings m_decodeSettings;
+	void DetectDualEngine(int engineInstance);
+
+	// Conversion utilities
+	double Celsius2Fahrenheit(double temperature);
+	double Fahrenheit2Celsius(double temperature);
+	double Pascal2Psi(double pressure);
+	double Psi2Pascal(double pressure);
+
+	// Used to parse JSON values from SignalK
+	wxJSONValue root;
+	wxJSONReader jsonReader;
+	wxString self;
+	void ParseSignalK(const wxString &message_body);
+	void HandleSKUpdate(wxJSONValue &update);
+	void UpdateSKItem(wxJSONValue &item);
+	double GetJsonDouble(wxJSONValue &value); // FFS
+	bool CheckAlarmState(wxJSONValue& value);
+
+	// Used to parse NMEA Sentences
+	NMEA0183 m_NMEA0183;
+	void DecodeXDR(wxString &sentence);
+	void DecodeRPM(wxString &sentence);
+	void DecodeRSA(wxString &sentence);
+
+	// NMEA 2000
+	// index into the payload.
+	// The payload is in Actisense format, so as I've just pasted code from twocan, this simplifies 
+	// accessing the data
+	const int index = 13;
+	// Engine Parameters - Rapid Update
+	void DecodeN2K_127488(const std::vector<uint8_t> &payload);
+	// Engine Parameters - Dynamic
+	void DecodeN2K_127489(const std::vector<uint8_t> &payload);
+	// Fluid Levels
+	void DecodeN2K_127505(const std::vector<uint8_t> &payload);
+	// Battery Status
+	void DecodeN2K_127508(const std::vector<uint8_t> &payload);
+	// Temperature
+	void DecodeN2K_130312(const std::vector<uint8_t> &payload);
+	// Rudder Angle
+	void DecodeN2K_127245(const std::vector<uint8_t> &payload);
+
+	// NMEA 2000 Data Validation
+	template<typename T>
+	static bool IsDataValid(T value);
+
+	static bool IsDataValid(byte value) {
+		if ((value == UCHAR_MAX) || (value == UCHAR_MAX - 1) || (value == UCHAR_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(char value) {
+		if ((value == CHAR_MAX) || (value == CHAR_MAX - 1) || (value == CHAR_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(unsigned short value) {
+		if ((value == USHRT_MAX) || (value == USHRT_MAX - 1) || (value == USHRT_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(short value) {
+		if ((value == SHRT_MAX) || (value == SHRT_MAX - 1) || (value == SHRT_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(unsigned int value) {
+		if ((value == UINT_MAX) || (value == UINT_MAX - 1) || (value == UINT_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(int value) {
+		if ((value == INT_MAX) || (value == INT_MAX - 1) || (value == INT_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(unsigned long value) {
+		if ((value == ULONG_MAX) || (value == ULONG_MAX - 1) || (value == ULONG_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(long value) {
+		if ((value == LONG_MAX) || (value == LONG_MAX - 1) || (value == LONG_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(unsigned long long value) {
+		if ((value == ULLONG_MAX) || (value == ULLONG_MAX - 1) || (value == ULLONG_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	static bool IsDataValid(long long value) {
+		if ((value == LLONG_MAX) || (value == LLONG_MAX - 1) || (value == LLONG_MAX - 2)) {
+			return FALSE;
+		}
+		else {
+			return TRUE;
+		}
+	}
+
+	// Store the current engine hours for displaying in the Tachometer Dial
+	double mainEngineHours;
+	double portEngineHours;
+	double stbdEngineHours;
+};
+
+#endif // _DECODER_H_
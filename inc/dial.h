@@ -55,6 +55,7 @@
 #endif
 
 #include "instrument.h"
+#include <vector>
 
 // 0 degrees are at 12 o´clock
 #define ANGLE_OFFSET 90
@@ -85,11 +86,76 @@ typedef enum {
 	DIAL_POSITION_BOTTOMRIGHT
 } DialPositionOption;
 
+// Draw phases, in the order in which they are painted, see DrawPhase
+typedef enum {
+	DIAL_PHASE_LABELS,
+	DIAL_PHASE_FRAME,
+	DIAL_PHASE_MARKERS,
+	DIAL_PHASE_BACKGROUND,
+	DIAL_PHASE_WARNING,
+	DIAL_PHASE_DATA,
+	DIAL_PHASE_FOREGROUND,
+	DIAL_PHASE_COUNT
+} DialDrawPhase;
+
+typedef enum {
+	DIAL_ARC_FRAME,
+	DIAL_ARC_RED,
+	DIAL_ARC_GREEN
+} DialArcColour;
+
+// Precomputed dial geometry, calculated once per size and scale rather than on each paint
+
+// Centre, radius and client width that a geometry table was calculated for
+struct DialGeometryKey {
+	int cx, cy, radius, width;
+	bool operator==(const DialGeometryKey &other) const {
+		return (cx == other.cx) && (cy == other.cy) && (radius == other.radius) && (width == other.width);
+	}
+};
+
+struct DialMarker {
+	wxPoint inner;
+	wxPoint outer;
+	// Degrees clockwise from 12 o'clock
+	int angle;
+	// Shorter ticks between the major ticks, omitted at reduced quality
+	bool minor;
+};
+
+struct DialLabel {
+	double angle;
+	double cosine;
+	double sine;
+	wxString text;
+	// Pre-rendered label, horizontal or rotated, and its offset from the text origin
+	wxBitmap sprite;
+	wxPoint spriteOffset;
+	int width, height;
+};
+
+struct DialArc {
+	wxPoint start;
+	wxPoint end;
+	DialArcColour colour;
+};
+
 extern double rad2deg(double angle);
 extern double deg2rad(double angle);
 
 extern wxString iconFolder;
 
+// Engine alarm icons are indexed by the bit number in the engine status word
+#define WARNING_ICON_COUNT 16
+// Time (milliseconds) an alarm is displayed after its last report
+#define WARNING_TIMEOUT 5000
+// Smallest size (pixels) to which the alarm icons are reduced to fit several alarms
+#define WARNING_ICON_MIN_SIZE 16
+
+// Rasterized alarm icons, shared by all dials. The dimension is in logical pixels,
+// the icons are rasterized at the content scale factor's device pixels.
+extern const wxBitmap &GetWarningIcon(int icon, int dimension, double scale);
+
 //+------------------------------------------------------------------------------
 //|
 //| CLASS:
@@ -111,21 +177,35 @@ public:
 	void SetOptionMainValue(wxString format, DialPositionOption option);
 	void SetOptionExtraValue(DASH_CAP cap, wxString format, DialPositionOption option);
 	void SetOptionWarningValue(DASH_CAP cap);
+	// Time (seconds) for the needle to settle on a new value, zero to disable animation
+	void SetOptionNeedleDamping(double seconds) { m_NeedleDamping = seconds; }
+
+	bool IsAnimating(void) { return m_NeedleMoving; }
+	bool Animate(wxLongLong now);
+	wxRect GetDamageRect(void);
+	// Draws a single phase, without the static layer, eg. to time each phase separately
+	void DrawPhase(wxGCDC *dc, DialDrawPhase phase);
 private:
 
 protected:
 	int m_cx, m_cy, m_radius;
 	int m_AngleStart, m_AngleRange;
 	double m_MainValue;
+	// Position of the needle as it moves towards m_MainValue
+	double m_NeedleValue;
+	double m_NeedleVelocity;
+	double m_NeedleDamping;
+	bool m_NeedleMoving;
+	wxLongLong m_NeedleTime;
 	DASH_CAP m_MainValueCap;
 	double m_MainValueMin, m_MainValueMax;
-	wxString m_MainValueFormat;
+	ValueFormatter m_MainValueFormatter;
 	wxString m_MainValueUnit;
 	DialPositionOption m_MainValueOption;
 	double m_ExtraValue;
 	DASH_CAP m_ExtraValueCap;
 	DASH_CAP m_WarningValueCap;
-	wxString m_ExtraValueFormat;
+	ValueFormatter m_ExtraValueFormatter;
 	wxString m_ExtraValueUnit;
 	DialPositionOption m_ExtraValueOption;
 	DialMarkerOption m_MarkerOption;
@@ -134,15 +214,55 @@ protected:
 	DialLabelOption m_LabelOption;
 	wxArrayString m_LabelArray;
 	// Engine Warning images
-	wxString imageFilename;
-	wxBitmap imageBitmap;
+	unsigned int m_warningStatus;
+	wxLongLong m_warningTimes[WARNING_ICON_COUNT];
+	bool m_warningsPainted;
+	// Areas covered by the needle and the values when last painted, used to limit repaints
+	bool m_damageValid;
+	wxRect m_needleRect;
+	wxRect m_dataRect;
+	void GetNeedlePoints(wxPoint points[4]);
+	wxRect GetNeedleRect(void);
+	// Frame, markers, labels and background, which only change with size, content scale, colour scheme, font or render quality
+	wxBitmap m_staticLayer;
+	PI_ColorScheme m_staticScheme;
+	RenderQuality m_staticQuality;
+	wxFont m_staticFont;
+	int m_staticCx, m_staticCy, m_staticRadius, m_staticTitleHeight;
+	bool IsStaticLayerValid(wxSize size);
+	void RenderStaticLayer(wxSize size);
+	void LayoutDial(wxSize size);
+
+	std::vector<DialMarker> m_markers;
+	DialGeometryKey m_markerKey;
+	std::vector<DialLabel> m_labels;
+	bool m_labelsValid;
+	bool m_spritesValid;
+	PI_ColorScheme m_spriteScheme;
+	double m_spriteScale;
+	DialLabelOption m_spriteLabelOption;
+	wxFont m_spriteFont;
+	std::vector<DialArc> m_arcs;
+	DialGeometryKey m_arcKey;
+	DialGeometryKey GetGeometryKey(void);
+	void InvalidateGeometry(void);
+	void UpdateMarkers(void);
+	void UpdateLabels(void);
+	void UpdateLabelSprites(wxGCDC *dc);
+	// Rotated labels are drawn horizontally at reduced quality
+	DialLabelOption GetLabelOption(void);
+	void UpdateArcs(void);
+	void AddArc(DialArcColour colour, double startAngle, double endAngle, int radius);
+
+	double GetValueSpan(void) { return m_MainValueMax - m_MainValueMin; }
+	void StartNeedle(void);
 	
 	virtual void Draw(wxGCDC* dc);
 	virtual void DrawFrame(wxGCDC* dc);
 	virtual void DrawMarkers(wxGCDC* dc);
 	virtual void DrawLabels(wxGCDC* dc);
 	virtual void DrawBackground(wxGCDC* dc);
-	virtual void DrawData(wxGCDC* dc, double value, wxString unit, wxString format, DialPositionOption position);
+	virtual void DrawData(wxGCDC* dc, double value, const wxString &unit, ValueFormatter &formatter, DialPositionOption position);
 	virtual void DrawForeground(wxGCDC* dc);
 	virtual void DrawWarning(wxGCDC* dc);
 };
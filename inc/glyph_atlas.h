@@ -0,0 +1,85 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Pre-rasterized glyphs for the numeric readouts. The digits, sign, decimal point and
+// space are rendered once per font, colour scheme and content scale, as are the characters
+// of the unit suffixes when first used, so that a value is drawn as one blit per character
+// rather than laying out the text on every paint.
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _GLYPHATLAS_H_
+#define _GLYPHATLAS_H_
+
+#include <wx/wxprec.h>
+
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#include <map>
+
+// Characters rasterized when an atlas is created
+#define GLYPH_ATLAS_PRESET _T("0123456789-+. ")
+// Characters with a code below this are held in a table, the remainder in a map
+#define GLYPH_ATLAS_TABLE_SIZE 128
+// Once exceeded, eg. after the fonts have been changed several times, the atlases are discarded
+#define MAX_GLYPH_ATLASES 8
+
+struct Glyph {
+	// Opaque, drawn on the background colour
+	wxBitmap bitmap;
+	// Advance, in logical pixels
+	int width;
+	int height;
+};
+
+class GlyphAtlas {
+public:
+	GlyphAtlas(const wxFont &font, const wxColour &foreground, const wxColour &background, double scale);
+
+	bool Matches(const wxFont &font, const wxColour &foreground, const wxColour &background, double scale) const;
+
+	// Lines are separated by newlines. The width is that of the widest line.
+	void GetTextExtent(const wxString &text, int *width, int *height);
+	void DrawText(wxDC *dc, const wxString &text, int x, int y);
+
+private:
+	wxFont m_font;
+	wxColour m_foreground;
+	wxColour m_background;
+	double m_scale;
+	int m_lineHeight;
+
+	Glyph m_table[GLYPH_ATLAS_TABLE_SIZE];
+	std::map<wxChar, Glyph> m_others;
+
+	const Glyph &GetGlyph(wxChar c);
+	void Rasterize(wxChar c, Glyph &glyph);
+};
+
+// Atlas for the font and colours, created on first use
+extern GlyphAtlas &GetGlyphAtlas(const wxFont &font, const wxColour &foreground, const wxColour &background, double scale);
+// Must be invoked whenever the fonts are changed
+extern void InvalidateGlyphAtlases(void);
+
+#endif // _GLYPHATLAS_H_
@@ -39,8 +39,9 @@
   #include "wx/wx.h"
 #endif //precompiled headers
 
+// Instruments draw through wxGCDC, both alone and in the window's composite pass
 #if !wxUSE_GRAPHICS_CONTEXT
-#define wxGCDC wxDC
+#error "The dashboard requires wxWidgets built with wxUSE_GRAPHICS_CONTEXT"
 #endif
 
 // Required GetGlobalColor
@@ -50,16 +51,95 @@
 
 // Used by the Dashboard Capability Enums
 #include <bitset>
+#include <vector>
+
+#include "value_formatter.h"
 
 // This is the degree sign in UTF8. It should be correctly handled on both Win & Unix
 const wxString DEGREE_SIGN = wxString::Format(_T("%c"), 0x00B0); 
 
 #define DefaultWidth 150
 
+// Number of cells in a block gauge, each representing 10%
+#define BLOCK_CELLS 10
+
+// Adaptive refresh scheduling (milliseconds)
+// Instruments are refreshed at the rate their data arrives, bounded by these limits.
+// If the value has moved less than the threshold (fraction of the instrument's span)
+// since it was last painted, the refresh is deferred to the maximum interval.
+#define MIN_REFRESH_INTERVAL 100
+#define MAX_REFRESH_INTERVAL 1000
+#define REFRESH_MOVEMENT_THRESHOLD 0.005
+#define MAX_REFRESH_CHANNELS 4
+
+// Needle animation, frame interval (milliseconds) while a needle is moving.
+// A needle is settled once within the threshold (fraction of the instrument's span) of its value.
+#define ANIMATION_INTERVAL 33
+#define ANIMATION_SETTLE_THRESHOLD 0.001
+
 extern wxFont *g_pFontTitle;
 extern wxFont *g_pFontData;
 extern wxFont *g_pFontLabel;
 extern wxFont *g_pFontSmall;
+// Current colour scheme, used to invalidate cached drawings
+extern PI_ColorScheme g_ColorScheme;
+
+// Dashboard colours, resolved once whenever the colour scheme changes
+// rather than looked up by name on each paint
+struct DashboardPalette {
+	wxColour background; // DASHB
+	wxColour title;      // DASHL
+	wxColour foreground; // DASHF
+	wxColour red;        // DASHR
+	wxColour green;      // DASHG
+	wxColour needle;     // DASHN
+	wxColour hub;        // DASH1
+	wxColour hubOutline; // DASH2
+};
+
+extern DashboardPalette g_Palette;
+extern void UpdatePalette(void);
+
+// Text extents, measured once per font and string so that layout does not require a DC.
+// Must be invalidated whenever the fonts are changed.
+extern void GetCachedTextExtent(const wxString &text, const wxFont *font, int *width, int *height);
+extern void InvalidateTextExtentCache(void);
+
+// Cached bitmaps are created at device pixel resolution, so that they remain sharp
+// on HiDPI displays, and are recreated if the window's content scale factor changes.
+extern double GetContentScale(wxWindow *window);
+extern void CreateScaledBitmap(wxBitmap &bitmap, wxSize size, double scale);
+extern bool IsScaledBitmapValid(const wxBitmap &bitmap, wxSize size, double scale);
+
+// Render quality, stepped down by the frame budget governor whilst painting takes too long.
+// Each level includes the reductions of the levels before it.
+typedef enum {
+	QUALITY_FULL,
+	QUALITY_NO_ANTIALIAS,
+	QUALITY_NO_MINOR_TICKS,
+	QUALITY_NO_ROTATED_LABELS,
+	QUALITY_REDUCED_RATE,
+	QUALITY_COUNT
+} RenderQuality;
+
+// Refresh and animation intervals are multiplied by this at the reduced rate
+#define REDUCED_RATE_FACTOR 2
+
+extern RenderQuality GetRenderQuality(void);
+extern void SetRenderQuality(RenderQuality quality);
+extern wxString GetRenderQualityName(RenderQuality quality);
+extern int GetAnimationInterval(void);
+// Time (milliseconds) spent painting the instruments' windows since this was last called.
+// Only the paint handlers add to it, not paints requested by the harness or benchmarks.
+extern void AddPaintTime(double time);
+extern double TakePaintTime(void);
+
+// Back-buffers, which persist between paints and are only reallocated when resized.
+// The memory used by all of them is accounted for, and reported by the diagnostics.
+extern void ResizeBackBuffer(wxBitmap &buffer, wxSize size, double scale);
+extern void ReleaseBackBuffer(wxBitmap &buffer);
+extern int GetBackBufferCount(void);
+extern unsigned long GetBackBufferMemory(void);
 
 wxString toSDMM(int NEflag, double a);
 
@@ -116,32 +196,85 @@ enum DASH_CAP {
 };
 
 #define N_INSTRUMENTS  ((int)OCPN_DBP_STC_LAST)  // Number of instrument capability flags
+
+// Unit sent with an engine fault value that is the entire NMEA 2000 status word,
+// rather than a single SignalK alarm
+#define FAULT_STATUS_WORD _T("Status")
 using CapType = std::bitset<N_INSTRUMENTS>;
 
+// Last painted & latest value of each capability an instrument displays
+struct RefreshChannel {
+	DASH_CAP cap;
+	double painted;
+	double latest;
+};
+
 class DashboardInstrument : public wxControl {
 public:
 	DashboardInstrument(wxWindow *pparent, wxWindowID id, wxString title, DASH_CAP cap_flag);
-	~DashboardInstrument(){}
+	~DashboardInstrument();
 
 	CapType GetCapacity();
 	void OnEraseBackground(wxEraseEvent &WXUNUSED(evt));
 	virtual wxSize GetSize(int orient, wxSize hint) = 0;
 	void OnPaint(wxPaintEvent &WXUNUSED(event));
+	// Paints the area of the instrument that needs updating, either from OnPaint or,
+	// when composited, by the dashboard window into its own back-buffer
+	void Paint(wxGCDC &dc, wxDC &pdc, const wxRect &update);
+	// When composited, the instrument is only a layout cell and the dashboard window paints it
+	void SetComposited(bool value) { m_composited = value; }
+	bool IsComposited(void) { return m_composited; }
 	virtual void SetData(DASH_CAP st, double data, wxString unit) = 0;
 	void SetCapFlag(DASH_CAP val) { m_cap_flag.set(val); }
 	bool HasCapFlag(DASH_CAP val) { return m_cap_flag.test(val); }
 	void SetDrawSoloInPane(bool value);
 	void MouseEvent(wxMouseEvent &event);
 	int instrumentTypeId;
+	wxString GetCaption() { return m_title; }
+
+	// Adaptive refresh scheduling
+	void NotifyDataUpdate(DASH_CAP st, double value);
+	bool IsRefreshDue(wxLongLong now);
+	void ScheduleRefresh(void);
+	void RefreshDamage(void);
+	double GetTargetInterval(void);
+	double GetPaintCost(void) { return m_paintCost; }
+	double GetActualRate(wxLongLong now);
+	// Area that must be repainted to show the latest values, by default the entire instrument
+	virtual wxRect GetDamageRect(void) { return GetClientRect(); }
+
+	// Needle animation, returns true whilst still moving
+	virtual bool IsAnimating(void) { return false; }
+	virtual bool Animate(wxLongLong now) { return false; }
 
 protected:
 	CapType m_cap_flag;
 	int m_TitleHeight;
 	wxString m_title;
+	// Area being repainted, drawing is clipped to it
+	wxRect m_updateRect;
 	virtual void Draw(wxGCDC *dc) = 0;
+	// Range of values displayed, used to determine how far a value has moved
+	virtual double GetValueSpan(void) { return 100.0; }
+	// Whether the values received since the last paint change what is displayed
+	virtual bool IsDisplayChanged(void) { return true; }
 
 private:
 	bool m_drawSoloInPane;
+	bool m_composited;
+	wxBitmap m_backBuffer;
+
+	bool m_dirty;
+	bool m_refreshPending;
+	double m_updateInterval;
+	double m_paintCost;
+	wxLongLong m_lastDataTime;
+	wxLongLong m_lastPaintTime;
+	unsigned long m_paintCount;
+	unsigned long m_ratePaintCount;
+	wxLongLong m_rateTime;
+	int m_channelCount;
+	RefreshChannel m_channels[MAX_REFRESH_CHANNELS];
 };
 
 class DashboardInstrument_Single : public DashboardInstrument {
@@ -151,26 +284,36 @@ public:
 
 	wxSize GetSize(int orient, wxSize hint);
 	void SetData(DASH_CAP st, double data, wxString unit);
+	wxRect GetDamageRect(void);
 
 protected:
 	wxString m_data;
-	wxString m_format;
+	ValueFormatter m_formatter;
 	int m_DataHeight;
 	
 	void Draw(wxGCDC *dc);
 };
 
-// A simple gauge using the wxGauge Control
+// A simple bar gauge, displaying a percentage such as a tank level
 class DashboardInstrument_Gauge : public DashboardInstrument
 {
 public:
 	DashboardInstrument_Gauge(wxWindow *pparent, wxWindowID id, wxString title, DASH_CAP cap_flag);
 	~DashboardInstrument_Gauge(void);
-	wxGauge *gauge;
 	wxSize GetSize(int orient, wxSize hint);
 	void SetData(DASH_CAP st, double data, wxString unit);
+	wxRect GetDamageRect(void);
+	// The bar is drawn in red at or below the low, or above the high percentage, eg. fuel or black water
+	void SetOptionThresholds(int low, int high) { m_lowThreshold = low; m_highThreshold = high; }
 
 protected:
+	// Percentage displayed, or -1 if there is no data
+	int m_percent;
+	int m_paintedPercent;
+	int m_lowThreshold;
+	int m_highThreshold;
+	ValueFormatter m_formatter;
+	bool IsDisplayChanged(void) { return m_percent != m_paintedPercent; }
 	void Draw(wxGCDC* dc);
 
 };
@@ -183,13 +326,23 @@ public:
 
 	wxSize GetSize(int orient, wxSize hint);
 	void SetData(DASH_CAP st, double data, wxString unit);
+	wxRect GetDamageRect(void);
 
 protected:
-	wxString          m_data;
 	wxString          m_format;
 	int               m_DataHeight;
+	// Level as a percentage, or -1 if there is no data
 	int 			  m_Value;
+	int               m_paintedValue;
+	ValueFormatter    m_formatter;
+	// Cells, each representing 10%, and the position of the percentage, for the current size
+	wxSize            m_geometrySize;
+	int               m_geometryDataHeight;
+	std::vector<wxRect> m_cells;
+	int               m_textX;
 
+	void UpdateGeometry(wxSize size);
+	bool IsDisplayChanged(void) { return m_Value != m_paintedValue; }
 	void Draw(wxGCDC* dc);
 };
 
@@ -0,0 +1,118 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Bounded single producer/single consumer lock free queue.
+// Used to hand raw NMEA 0183, NMEA 2000 & SignalK payloads from the UI thread
+// to the decode thread, and the decoded values back again.
+// Slots are reused, so once the queue has warmed up, pushing a payload
+// of similar size does not allocate.
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _SPSCQUEUE_H_
+#define _SPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+
+// N must be a power of two
+template <typename T, size_t N>
+class SpscQueue {
+	static_assert((N != 0) && ((N & (N - 1)) == 0), "SpscQueue size must be a power of two");
+
+public:
+	SpscQueue() : m_head(0), m_tail(0), m_dropped(0) {}
+
+	// Producer. Returns the next free slot to be filled, or NULL if the queue is full,
+	// in which case the item is counted as dropped. The slot is not visible to the
+	// consumer until Push is called.
+	T *Reserve() {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (head - m_tail.load(std::memory_order_acquire) >= N) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return NULL;
+		}
+		return &m_slots[head & (N - 1)];
+	}
+
+	void Push() {
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	// Consumer. Returns the oldest item, or NULL if the queue is empty.
+	// The slot remains owned by the consumer until Pop is called.
+	T *Front() {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail == m_head.load(std::memory_order_acquire)) {
+			return NULL;
+		}
+		return &m_slots[tail & (N - 1)];
+	}
+
+	void Pop() {
+		m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	// Consumer. Returns the number of items that are stored contiguously from the oldest,
+	// which is less than the depth when the items wrap around the end of the slots.
+	size_t FrontSpan(T **front) {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t count = m_head.load(std::memory_order_acquire) - tail;
+		size_t slot = tail & (N - 1);
+		if (count > N - slot) {
+			count = N - slot;
+		}
+		*front = &m_slots[slot];
+		return count;
+	}
+
+	void Pop(size_t count) {
+		m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+	}
+
+	// Statistics, may be read from either thread
+	size_t GetDepth() const {
+		// Read the tail first, so that a concurrent push or pop cannot make the depth negative
+		size_t tail = m_tail.load(std::memory_order_acquire);
+		return m_head.load(std::memory_order_acquire) - tail;
+	}
+
+	size_t GetCapacity() const {
+		return N;
+	}
+
+	unsigned long GetDropped() const {
+		return m_dropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	T m_slots[N];
+	// Pad the producer and consumer indices onto separate cache lines
+	char m_pad0[64];
+	std::atomic<size_t> m_head;
+	char m_pad1[64];
+	std::atomic<size_t> m_tail;
+	char m_pad2[64];
+	std::atomic<unsigned long> m_dropped;
+};
+
+#endif // _SPSCQUEUE_H_
@@ -0,0 +1,140 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Routing and dispatch of the values received by the plugin, shared with the allocation
+// budget test so that it measures the same code. Raw payloads are copied into the ingest
+// queue, the decoded values into the decoded queue, and from there to the instruments.
+// Each reuses the capacity of the slots and of the latest values, so once warmed up none
+// of them allocate.
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _VALUEDISPATCH_H_
+#define _VALUEDISPATCH_H_
+
+#include "decoder.h"
+#include "spsc_queue.h"
+
+#include <vector>
+
+// Fills the next free slot of the ingest queue with a payload, without pushing it. Returns
+// the slot, or NULL if the queue is full. The caller either pushes it, or decodes it in place.
+template <size_t N>
+IngestItem *ReserveIngestItem(SpscQueue<IngestItem, N> &queue, IngestType type, const wxString &sentence) {
+	IngestItem *item = queue.Reserve();
+	if (item != NULL) {
+		item->type = type;
+		item->sentence = sentence;
+	}
+	return item;
+}
+
+template <size_t N>
+IngestItem *ReserveIngestItem(SpscQueue<IngestItem, N> &queue, IngestType type, const std::vector<uint8_t> &payload) {
+	IngestItem *item = queue.Reserve();
+	if (item != NULL) {
+		item->type = type;
+		// Reuses the capacity of the slot's vector
+		item->payload.assign(payload.begin(), payload.end());
+	}
+	return item;
+}
+
+// Queues decoded values for the UI thread, returns false if the queue filled
+template <size_t N>
+bool QueueDecodedValue(SpscQueue<DecodedValue, N> &queue, DASH_CAP st, double value, const wxString &unit) {
+	DecodedValue *decoded = queue.Reserve();
+	if (decoded == NULL) {
+		return false;
+	}
+	decoded->cap = st;
+	decoded->value = value;
+	decoded->unit = unit;
+	queue.Push();
+	return true;
+}
+
+template <size_t N>
+bool QueueDecodedValues(SpscQueue<DecodedValue, N> &queue, const DecodedValue *values, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		DecodedValue *decoded = queue.Reserve();
+		if (decoded == NULL) {
+			return false;
+		}
+		*decoded = values[i];
+		queue.Push();
+	}
+	return true;
+}
+
+// Sends an instrument whichever of the values it displays, returns whether it received any
+inline bool SendValuesToInstrument(DashboardInstrument *instrument, const CapType &caps, const DecodedValue *values, size_t count) {
+	bool updated = false;
+	for (size_t i = 0; i < count; i++) {
+		if (caps.test(values[i].cap)) {
+			instrument->SetData(values[i].cap, values[i].value, values[i].unit);
+			instrument->NotifyDataUpdate(values[i].cap, values[i].value);
+			updated = true;
+		}
+	}
+	return updated;
+}
+
+// The latest value of each channel, used to bring a dashboard up to date when it is shown
+class LatestValues {
+public:
+	void Store(DASH_CAP st, double value, const wxString &unit) {
+		if ((st < 0) || (st >= N_INSTRUMENTS)) {
+			return;
+		}
+		DecodedValue &latest = m_values[st];
+		latest.cap = st;
+		latest.value = value;
+		// Units rarely change, so avoid copying the text for every value
+		if (latest.unit != unit) {
+			latest.unit = unit;
+		}
+		m_valid.set(st);
+	}
+
+	void Store(const DecodedValue *values, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			Store(values[i].cap, values[i].value, values[i].unit);
+		}
+	}
+
+	// Copies the latest value of each channel received, replacing the contents of values
+	void GetValues(std::vector<DecodedValue> &values) const {
+		values.clear();
+		for (int i = 0; i < N_INSTRUMENTS; i++) {
+			if (m_valid.test(i)) {
+				values.push_back(m_values[i]);
+			}
+		}
+	}
+
+private:
+	DecodedValue m_values[N_INSTRUMENTS];
+	CapType m_valid;
+};
+
+#endif
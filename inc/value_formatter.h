@@ -0,0 +1,90 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Precompiled value formatter, used for the text displayed by the instruments.
+// The printf style format and the unit's prefix & suffix are compiled once,
+// after which each value is written as fixed point digits into a reused buffer,
+// rather than parsing the format and concatenating strings for every update.
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _VALUEFORMATTER_H_
+#define _VALUEFORMATTER_H_
+
+#include <wx/string.h>
+
+// Maximum length of a formatted value, including the prefix and suffix
+#define MAX_FORMATTED_LENGTH 64
+// Maximum number of decimal places written by the fixed point routine
+#define MAX_FORMAT_PRECISION 6
+
+class ValueFormatter {
+public:
+	ValueFormatter();
+
+	// Compiles a printf style format containing a single %d, %i or %f conversion,
+	// with optional flags (-, +, space, 0), width and precision, and literal text.
+	// Any other conversion is passed to wxString::Format when the value is formatted.
+	void SetFormat(const wxString &format);
+
+	// Compiles the text written before and after the value for the given unit
+	bool HasUnit(const wxString &unit) const { return m_unitValid && (unit == m_unit); }
+	void SetUnit(const wxString &unit, const wxString &prefix, const wxString &suffix);
+
+	// Formats the value into the buffer, which remains valid until the next call
+	const wxChar *Format(double value, size_t *length);
+	// Formats the value into text, reusing the text's storage where possible
+	void Format(double value, wxString &text);
+	// Formats the value into the formatter's own text, which remains valid until the next call
+	const wxString &Format(double value);
+
+private:
+	// Text surrounding the conversion, and the unit's prefix & suffix
+	wxString m_format;
+	wxString m_leading;
+	wxString m_trailing;
+	wxString m_unit;
+	bool m_unitValid;
+	wxString m_prefix;
+	wxString m_suffix;
+
+	// The compiled conversion
+	bool m_compiled;
+	bool m_leftAlign;
+	bool m_zeroPad;
+	wxChar m_sign;
+	int m_width;
+	int m_precision;
+	long long m_scale;
+
+	// Buffer, the prefix and leading text are copied once when compiled
+	wxChar m_buffer[MAX_FORMATTED_LENGTH];
+	size_t m_head;
+	// False once a value formatted by wxString::Format has overwritten the prefix and leading text
+	bool m_prepared;
+	wxString m_text;
+
+	void Prepare(void);
+	size_t Append(size_t position, const wxString &text);
+};
+
+#endif // _VALUEFORMATTER_H_
@@ -65,13 +65,16 @@
 #include "dashboard_pi.h"
 
 #include <typeinfo>
+#include <algorithm>
 #include "icons.h"
+#include "glyph_atlas.h"
 
 // Global variables for fonts
 wxFont *g_pFontTitle;
 wxFont *g_pFontData;
 wxFont *g_pFontLabel;
 wxFont *g_pFontSmall;
+PI_ColorScheme g_ColorScheme = PI_GLOBAL_COLOR_SCHEME_DAY;
 
 // Preferences, Units and Max Values
 int g_iDashTachometerMax;
@@ -87,6 +90,10 @@ bool dualEngine;
 // If the voltmeter display range is for 12 or 24 volt systems.
 bool twentyFourVolts;
 
+// If each dashboard paints all of its instruments into a single back-buffer,
+// rather than each instrument painting its own window
+bool g_bCompositeRendering;
+
 
 #if !defined(NAN)
 static const long long lNaN = 0xfff8000000000000;
@@ -125,6 +132,8 @@ enum {
 	ID_DBP_FUEL_TANK_02, ID_DBP_WATER_TANK_02, ID_DBP_WATER_TANK_03,
 	ID_DBP_FUEL_TANK_GAUGE_01, ID_DBP_FUEL_TANK_GAUGE_02, ID_DBP_WATER_TANK_GAUGE_01,
 	ID_DBP_WATER_TANK_GAUGE_02, ID_DBP_WATER_TANK_GAUGE_03,
+	ID_DBP_FUEL_TANK_BAR_01, ID_DBP_FUEL_TANK_BAR_02, ID_DBP_WATER_TANK_BAR_01,
+	ID_DBP_WATER_TANK_BAR_02, ID_DBP_WATER_TANK_BAR_03,
 	ID_DBP_LAST_ENTRY //this has a reference in one of the routines; defining a "LAST_ENTRY" and setting the reference to it, is one codeline less to change (and find) when adding new instruments :-)
 };
 
@@ -176,6 +185,16 @@ wxString GetInstrumentCaption(unsigned int id) {
 		case ID_DBP_WATER_TANK_03:
 		case ID_DBP_WATER_TANK_GAUGE_03:
 			return _("Water 3");
+		case ID_DBP_FUEL_TANK_BAR_01:
+			return _("Fuel 1 (Bar)");
+		case ID_DBP_FUEL_TANK_BAR_02:
+			return _("Fuel 2 (Bar)");
+		case ID_DBP_WATER_TANK_BAR_01:
+			return _("Water 1 (Bar)");
+		case ID_DBP_WATER_TANK_BAR_02:
+			return _("Water 2 (Bar)");
+		case ID_DBP_WATER_TANK_BAR_03:
+			return _("Water 3 (Bar)");
 		case ID_DBP_OIL_TANK:
 			return _("Oil");
 		case ID_DBP_LIVEWELL_TANK:
@@ -244,6 +263,11 @@ void GetListItemForInstrument(wxListItem &item, unsigned int id) {
 		case ID_DBP_WATER_TANK_GAUGE_01:
 		case ID_DBP_WATER_TANK_GAUGE_02:
 		case ID_DBP_WATER_TANK_GAUGE_03:
+		case ID_DBP_FUEL_TANK_BAR_01:
+		case ID_DBP_FUEL_TANK_BAR_02:
+		case ID_DBP_WATER_TANK_BAR_01:
+		case ID_DBP_WATER_TANK_BAR_02:
+		case ID_DBP_WATER_TANK_BAR_03:
 		// BUG BUG Should create a SVG image for a gauge
 			item.SetImage(0);
 			break;
@@ -316,9 +340,22 @@ wxString MakeName() {
 
 // Dashboard Constructor
 // BUG BUG Consider renaming the class to engine_dashboard_pi to avoid confusion when programming other dashboard projects
-dashboard_pi::dashboard_pi(void *ppimgr) : opencpn_plugin_118(ppimgr), wxTimer(this) {
+dashboard_pi::dashboard_pi(void *ppimgr) : opencpn_plugin_118(ppimgr), wxTimer(this), m_decoder(this) {
     // Create the PlugIn icons
     initialize_images();
+
+    m_pDecodeThread = NULL;
+    m_decoderIdle = false;
+    m_decoderExit = false;
+    m_decodedPending = false;
+    m_diagnostics = false;
+    m_diagnosticsTick = 0;
+    m_scheduleCursor = 0;
+    m_lastWatchDogCheck = 0;
+    m_frameBudget = DEFAULT_FRAME_BUDGET;
+    m_frameTime = 0;
+    m_overBudgetTicks = 0;
+    m_underBudgetTicks = 0;
 }
 
 // Dashboard Destructor
@@ -352,8 +389,12 @@ int dashboard_pi::Init(void) {
     // Get a pointer to the opencpn configuration object
     m_pconfig = GetOCPNConfigObject();
 
+    // Resolve the dashboard colours for the current colour scheme
+    UpdatePalette();
+
     // And load the configuration items
     LoadConfig();
+    PublishDecoderSettings();
 
     // Scaleable Vector Graphics (SVG) icons are stored in the following path.
 	iconFolder = GetPluginDataDir(PLUGIN_PACKAGE_NAME) + wxFileName::GetPathSeparator() + _T("data") + wxFileName::GetPathSeparator();
@@ -463,9 +504,20 @@ int dashboard_pi::Init(void) {
     // Initialize the watchdog timers
 	// Engine watchdog zeros tachometer, oil pressure & engine temperature if no RPM's received
 	// Tank level watchdog zeroes tanks if no tank level data is received
-	engineWatchDog = wxDateTime::Now() - wxTimeSpan::Seconds(5);
-	tankLevelWatchDog = wxDateTime::Now() - wxTimeSpan::Seconds(5);
-	Start(1000, wxTIMER_CONTINUOUS);
+	m_decoder.engineWatchDog = wxGetLocalTime() - WATCHDOG_TIMEOUT_COUNT;
+	m_decoder.tankLevelWatchDog = wxGetLocalTime() - WATCHDOG_TIMEOUT_COUNT;
+	Start(SCHEDULER_INTERVAL, wxTIMER_CONTINUOUS);
+
+	// Decoded values are posted back to the UI thread from the decode thread
+	Bind(wxEVT_THREAD, [&](wxThreadEvent &ev) {
+		OnDecodedValues(ev);
+	});
+
+	// Move all parsing of NMEA 0183, NMEA 2000 & SignalK data off the UI thread
+	// If the thread cannot be started, payloads are decoded synchronously
+	if (!StartDecodeThread()) {
+		wxLogMessage(_T("Engine Dashboard, Unable to start decode thread"));
+	}
 
 	// Reduced from the original dashboard requests
     return (WANTS_TOOLBAR_CALLBACK | INSTALLS_TOOLBAR_TOOL | WANTS_PREFERENCES | WANTS_CONFIG | WANTS_NMEA_SENTENCES | USES_AUI_MANAGER | WANTS_PLUGIN_MESSAGING | WANTS_NMEA_EVENTS);
@@ -480,6 +532,9 @@ bool dashboard_pi::DeInit(void) {
 	    Stop(); 
     }
 
+    // Stop decoding before the dashboards are destroyed
+    StopDecodeThread();
+
     // This appears to close each dashboard instance
     for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
         DashboardWindow *dashboard_window = m_ArrayOfDashboardWindow.Item(i)->m_pDashboardWindow;
@@ -496,49 +551,147 @@ bool dashboard_pi::DeInit(void) {
         DashboardWindowContainer *pdwc = m_ArrayOfDashboardWindow.Item(i);
         delete pdwc;
     }
+    m_ArrayOfDashboardWindow.Clear();
 
     // Unload the fonts
     delete g_pFontTitle;
     delete g_pFontData;
     delete g_pFontLabel;
     delete g_pFontSmall;
+    InvalidateTextExtentCache();
+    InvalidateGlyphAtlases();
 
     return true;
 }
 
-// Called for each timer tick, ensures valid data and refreshes each display
+// Called for each timer tick, refreshes each display and once a second ensures valid data
 void dashboard_pi::Notify()
 {
+	GovernQuality();
+	ScheduleRefresh();
+
+	wxLongLong now = wxGetLocalTimeMillis();
+	if ((now - m_lastWatchDogCheck) < 1000) {
+		return;
+	}
+	m_lastWatchDogCheck = now;
+
 	// BUG BUG Consider using OCPN_DBP_STC as the for loop constraints
-    if (wxDateTime::Now() > (engineWatchDog + wxTimeSpan::Seconds(5))) {
+    if (wxGetLocalTime() > (m_decoder.engineWatchDog + WATCHDOG_TIMEOUT_COUNT)) {
 		// Zero the engine instruments
 		// We go from zero to ID_DBP_FUEL_TANK_01 + 3, because there are three additional values
 		// in OCPN_DBP_STC_... (instrument.h) for the engine hours, which 
 		// do not have their own gauge, but populate the engine rpm gauges
 		for (int i = 0; i < ID_DBP_FUEL_TANK_01 + 3; i++) {
-			SendSentenceToAllInstruments((DASH_CAP)i,0.0f, "");
+			DispatchToAllInstruments((DASH_CAP)i,0.0f, wxEmptyString);
 		}
     }
 
-	if (wxDateTime::Now() > (tankLevelWatchDog + wxTimeSpan::Seconds(5))) {
+	if (wxGetLocalTime() > (m_decoder.tankLevelWatchDog + WATCHDOG_TIMEOUT_COUNT)) {
 		// Zero the tank instruments
-		// We go from ID_DBP_FUEL_TANK_01 + 3 to IDP_LAST_ENTRY + 3, 
+		// We go from ID_DBP_FUEL_TANK_01 + 3 to the last tank level, 
 		// because there are three additional values
 		// in OCPN_DBP_STC_... (instrument.h) for the engine hours, which 
-		// do not have their own gauge, but populate the engine rpm gauges
-		for (int i = ID_DBP_FUEL_TANK_01 + 3; i < ID_DBP_LAST_ENTRY + 3; i++) {
-			SendSentenceToAllInstruments((DASH_CAP)i, 0.0f, "");
+		// do not have their own gauge, but populate the engine rpm gauges.
+		// The bar gauges display the same values as the tank gauges
+		for (int i = ID_DBP_FUEL_TANK_01 + 3; i <= OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03; i++) {
+			DispatchToAllInstruments((DASH_CAP)i, 0.0f, wxEmptyString);
 		}
 	}
 
 
-    // Force a repaint of each instrument
-    for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
-	    DashboardWindow *dashboard_window = m_ArrayOfDashboardWindow.Item(i)->m_pDashboardWindow;
-	    if (dashboard_window) {
-	        dashboard_window->Refresh();
-	    }
-    }
+	if (m_diagnostics) {
+		if (++m_diagnosticsTick >= DIAGNOSTICS_INTERVAL) {
+			m_diagnosticsTick = 0;
+			LogDiagnostics();
+		}
+	}
+}
+
+// Refresh each instrument whose data has changed, at a rate determined by how often its data
+// arrives and how far its value has moved. Stops once the estimated paint time of the instruments
+// refreshed exceeds the budget, the remainder are refreshed on the next tick.
+void dashboard_pi::ScheduleRefresh(void) {
+	m_instrumentOrder.clear();
+	for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
+		DashboardWindowContainer *cont = m_ArrayOfDashboardWindow.Item(i);
+		if (!IsReceiving(cont)) {
+			continue;
+		}
+		for (size_t j = 0; j < cont->m_pDashboardWindow->GetInstrumentCount(); j++) {
+			m_instrumentOrder.push_back(cont->m_pDashboardWindow->GetInstrument(j));
+		}
+	}
+
+	size_t total = m_instrumentOrder.size();
+	if (total == 0) {
+		return;
+	}
+
+	wxLongLong now = wxGetLocalTimeMillis();
+	double cost = 0;
+	size_t start = m_scheduleCursor % total;
+	// Round robin, so that instruments at the end of the list are not starved
+	std::rotate(m_instrumentOrder.begin(), m_instrumentOrder.begin() + start, m_instrumentOrder.end());
+
+	for (size_t i = 0; i < total; i++) {
+		DashboardInstrument *instrument = m_instrumentOrder[i];
+		if (instrument->IsRefreshDue(now)) {
+			if ((cost > 0) && (cost + instrument->GetPaintCost() > REFRESH_BUDGET)) {
+				m_scheduleCursor = (start + i) % total;
+				return;
+			}
+			instrument->ScheduleRefresh();
+			// Ensure even instruments that are quick to paint consume some of the budget
+			cost += wxMax(instrument->GetPaintCost(), 0.1);
+			// The next tick starts after the last instrument refreshed
+			m_scheduleCursor = (start + i + 1) % total;
+		}
+	}
+}
+
+// Measures the time spent painting in each scheduler interval, and steps the quality down whilst
+// it exceeds the budget: no antialiasing, no minor ticks, no rotated labels, then a reduced rate
+void dashboard_pi::GovernQuality(void) {
+	m_frameTime = (0.8 * m_frameTime) + (0.2 * TakePaintTime());
+	if (m_frameBudget <= 0) {
+		return;
+	}
+
+	RenderQuality quality = GetRenderQuality();
+	if (m_frameTime > m_frameBudget) {
+		m_underBudgetTicks = 0;
+		if ((++m_overBudgetTicks >= GOVERNOR_DOWN_TICKS) && (quality + 1 < QUALITY_COUNT)) {
+			m_overBudgetTicks = 0;
+			quality = (RenderQuality)(quality + 1);
+		}
+	}
+	else if (m_frameTime < m_frameBudget * GOVERNOR_HEADROOM) {
+		m_overBudgetTicks = 0;
+		if ((++m_underBudgetTicks >= GOVERNOR_UP_TICKS) && (quality > QUALITY_FULL)) {
+			m_underBudgetTicks = 0;
+			quality = (RenderQuality)(quality - 1);
+		}
+	}
+	else {
+		m_overBudgetTicks = 0;
+		m_underBudgetTicks = 0;
+	}
+
+	if (quality != GetRenderQuality()) {
+		SetRenderQuality(quality);
+		// A running animation timer would otherwise keep the previous rate until the needles settle
+		for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
+			DashboardWindow *dashboard_window = m_ArrayOfDashboardWindow.Item(i)->m_pDashboardWindow;
+			if (dashboard_window) {
+				dashboard_window->RestartAnimationTimer();
+			}
+		}
+		if (m_diagnostics) {
+			wxLogMessage(_T("Engine Dashboard, Quality: %s, Frame: %.2f ms, Budget: %.2f ms"),
+				GetRenderQualityName(quality), m_frameTime, m_frameBudget);
+		}
+	}
 }
 
 int dashboard_pi::GetAPIVersionMajor() {
@@ -575,1230 +728,276 @@ wxString dashboard_pi::GetLongDescription() {
     return _(PLUGIN_LONG_DESCRIPTION);
 }
 
-// a few conversion functions
-double dashboard_pi::Celsius2Fahrenheit(double temperature) {
-	return (temperature * 9 / 5) + 32;
-}
-
-double dashboard_pi::Fahrenheit2Celsius(double temperature) {
-	return (temperature - 32) * 5 / 9;
-}
-
-double dashboard_pi::Pascal2Psi(double pressure) {
-	return pressure * 0.000145f;
-}
-
-double dashboard_pi::Psi2Pascal(double pressure) {
-	return pressure * 6894.745f;
-}
-
 // Sends the data value from the parsed NMEA sentence to each gauge
+// The decoders run on the decode thread, so the value is queued for the UI thread
 void dashboard_pi::SendSentenceToAllInstruments(DASH_CAP st, double value, wxString unit) {
-    for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
-        DashboardWindow *dashboard_window = m_ArrayOfDashboardWindow.Item(i)->m_pDashboardWindow;
-		if (dashboard_window) {
-			dashboard_window->SendSentenceToAllInstruments(st, value, unit);
-		}
-    }
-}
-
-// One of those FFS moments
-// Have to know the type of the value before retrieving.
-double dashboard_pi::GetJsonDouble(wxJSONValue &value) {
-	double d_ret;
-	if (value.IsDouble()) {
-		return d_ret = value.AsDouble();
-	}
-	else if (value.IsInt()) {
-		int i_ret = value.AsInt();
-		return d_ret = i_ret;
-	}
-	else {
-		return nan("");
+	if (wxThread::IsMain()) {
+		DispatchToAllInstruments(st, value, unit);
+		return;
 	}
-}
-
-// Receive & handle SignalK derived data
-void dashboard_pi::SetPluginMessage(wxString& message_id, wxString& message_body) {
-	if (message_id == _T("OCPN_CORE_SIGNALK")) {
-		
-		if (jsonReader.Parse(message_body, &root) > 0) {
-			wxLogMessage("Engine Dashboard, JSON Error in following");
-			wxLogMessage("%s", message_body);
-			wxArrayString jsonErrors = jsonReader.GetErrors();
-			for (auto it : jsonErrors) {
-				wxLogMessage(it);
-			}
-			return;
-		}
 
-		if (root.HasMember("self")) {
-			if (root["self"].AsString().StartsWith(_T("vessels.")))
-				self = (root["self"].AsString());  // for java server, and OpenPlotter node.js server 1.20
-			else
-				self = _T("vessels.") + (root["self"].AsString()); // for Node.js server
-		}
-
-		if (root.HasMember("context") && root["context"].IsString()) {
-			auto context = root["context"].AsString();
-			if (context != self) {
-				return;
-			}
-		}
+	QueueDecodedValue(m_decodedQueue, st, value, unit);
 
-		if (root.HasMember("updates") && root["updates"].IsArray()) {
-			wxJSONValue &updates = root["updates"];
-			for (int i = 0; i < updates.Size(); ++i) {
-				HandleSKUpdate(updates[i]);
-			}
-		}
+	// Only post one wakeup until the UI thread has drained the queue
+	if (!m_decodedPending.exchange(true)) {
+		wxQueueEvent(this, new wxThreadEvent());
 	}
 }
 
-void dashboard_pi::HandleSKUpdate(wxJSONValue &update) {
-	if (update.HasMember("values")	&& update["values"].IsArray()) {
-		for (int j = 0; j < update["values"].Size(); ++j) {
-			wxJSONValue &item = update["values"][j];
-			UpdateSKItem(item);
-		}
+// Queue each value from the message, with a single wakeup of the UI thread
+void dashboard_pi::SendBatchToAllInstruments(const DashboardBatch &batch) {
+	if (batch.GetCount() == 0) {
+		return;
 	}
-}
 
-void dashboard_pi::UpdateSKItem(wxJSONValue &item) {
-	if (item.HasMember("path") && item.HasMember("value")) {
-		const wxString &update_path = item["path"].AsString();
-		wxJSONValue &value = item["value"];
+	if (wxThread::IsMain()) {
+		DispatchToAllInstruments(batch.GetValues(), batch.GetCount());
+		return;
+	}
 
-		if (update_path.StartsWith("propulsion")) {
-			engineWatchDog = wxDateTime::Now();
-		}
+	QueueDecodedValues(m_decodedQueue, batch.GetValues(), batch.GetCount());
 
-		// Units in revolutions per second
-		if ((update_path == _T("propulsion.port.revolutions")) && (!dualEngine)) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, GetJsonDouble(value) * 60, "RPM");
-		}
+	if (!m_decodedPending.exchange(true)) {
+		wxQueueEvent(this, new wxThreadEvent());
+	}
+}
 
-		if ((update_path == _T("propulsion.port.revolutions")) && (dualEngine)) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, GetJsonDouble(value) * 60, "RPM");
-		}
+// Drain the values decoded by the decode thread, dispatching each contiguous run of values in one pass
+void dashboard_pi::OnDecodedValues(wxThreadEvent &event) {
+	if (event.GetId() == DECODE_EVENT_DUAL_ENGINE) {
+		dualEngine = true;
+		PublishDecoderSettings();
+		return;
+	}
 
-		if (update_path == _T("propulsion.starboard.revolutions")) {
-			// dualEngine = TRUE;
-			SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, GetJsonDouble(value) * 60, "RPM");
-		}
-		
-		// Units in volts
-		if ((update_path == _T("propulsion.port.alternatorVoltage")) && (!dualEngine)) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, GetJsonDouble(value), "Volts");
-		}
+	m_decodedPending = false;
+	DecodedValue *decoded;
+	size_t count;
+	while ((count = m_decodedQueue.FrontSpan(&decoded)) > 0) {
+		DispatchToAllInstruments(decoded, count);
+		m_decodedQueue.Pop(count);
+	}
+}
 
-		if ((update_path == _T("propulsion.port.alternatorVoltage")) && (dualEngine)) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, GetJsonDouble(value), "Volts");
+void dashboard_pi::DispatchToAllInstruments(DASH_CAP st, double value, const wxString &unit) {
+	m_latestValues.Store(st, value, unit);
+    for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
+        DashboardWindowContainer *cont = m_ArrayOfDashboardWindow.Item(i);
+		if (IsReceiving(cont)) {
+			cont->m_pDashboardWindow->SendSentenceToAllInstruments(st, value, unit);
 		}
+    }
+}
 
-		if (update_path == _T("propulsion.starboard.alternatorVoltage")) {
-			// dualEngine = TRUE;
-			SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, GetJsonDouble(value), "Volts");
+void dashboard_pi::DispatchToAllInstruments(const DecodedValue *values, size_t count) {
+	m_latestValues.Store(values, count);
+	for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
+		DashboardWindowContainer *cont = m_ArrayOfDashboardWindow.Item(i);
+		if (IsReceiving(cont)) {
+			cont->m_pDashboardWindow->SendBatchToAllInstruments(values, count);
 		}
+	}
+}
 
-		if (g_iDashPressureUnit == PRESSURE_BAR) {
-			// Units are in Pascals. 100000 Pascals = 1 Bar
-			if ((update_path == _T("propulsion.port.oilPressure")) && (!dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, GetJsonDouble(value) * 1e-5, "Bar");
-			}
+// Whether the dashboard is shown and so should receive values and be painted. A dashboard that has
+// been hidden, or whose instruments have been replaced, is first sent the latest value of each channel.
+bool dashboard_pi::IsReceiving(DashboardWindowContainer *cont) {
+	DashboardWindow *dashboard_window = cont->m_pDashboardWindow;
+	if ((dashboard_window == NULL) || cont->m_bIsDeleted) {
+		return false;
+	}
 
-			if ((update_path == _T("propulsion.port.oilPressure")) && (dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, GetJsonDouble(value) * 1e-5, "Bar");
-			}
+	if (!dashboard_window->IsShownOnScreen()) {
+		cont->m_bSuspended = true;
+		return false;
+	}
 
-			if (update_path == _T("propulsion.starboard.oilPressure")) {
-				// dualEngine = TRUE;
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, GetJsonDouble(value) * 1e-5, "Bar");
-			}
+	if (cont->m_bSuspended) {
+		cont->m_bSuspended = false;
+		m_latestValues.GetValues(m_replayValues);
+		if (!m_replayValues.empty()) {
+			dashboard_window->SendBatchToAllInstruments(&m_replayValues[0], m_replayValues.size());
 		}
+	}
+	return true;
+}
 
-		else if (g_iDashPressureUnit == PRESSURE_PSI) {
-			if ((update_path == _T("propulsion.port.oilPressure")) && (!dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(GetJsonDouble(value)), "Psi");
-			}
-
-			if ((update_path == _T("propulsion.port.oilPressure")) && (dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(GetJsonDouble(value)), "Psi");
-			}
+//---------------------------------------------------------------------------------------------------------
+//
+//          Decode Thread
+//
+//---------------------------------------------------------------------------------------------------------
 
-			if (update_path == _T("propulsion.starboard.oilPressure")) {
-				// dualEngine = TRUE;
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(GetJsonDouble(value)), "Psi");
-			}
+// The listeners & SetPluginMessage are invoked on the UI thread. They only copy the raw payload
+// into the ingest queue, the decode thread then parses it and queues the values for the UI thread.
+void *DashboardDecodeThread::Entry() {
+	while (!m_plugin->m_decoderExit) {
+		m_plugin->DecodeIngestQueue();
+
+		// Nothing left to decode, sleep until the UI thread queues another payload
+		m_plugin->m_decoderIdle = true;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if ((m_plugin->m_ingestQueue.GetDepth() == 0) && (!m_plugin->m_decoderExit)) {
+			m_plugin->m_ingestSignal.Wait();
 		}
-		
-		if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-			// Units are in Kelvin
-			if ((update_path == _T("propulsion.port.temperature")) && (!dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
-			}
-
-			if ((update_path == _T("propulsion.port.temperature")) && (dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
-			}
+		m_plugin->m_decoderIdle = false;
+	}
+	return NULL;
+}
 
-			if (update_path == _T("propulsion.starboard.temperature")) {
-				// dualEngine = TRUE;
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
-			}
+bool dashboard_pi::StartDecodeThread(void) {
+	m_decoderExit = false;
+	m_pDecodeThread = new DashboardDecodeThread(this);
+	if (m_pDecodeThread->Run() != wxTHREAD_NO_ERROR) {
+		delete m_pDecodeThread;
+		m_pDecodeThread = NULL;
+		return false;
+	}
+	return true;
+}
 
-			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (!dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
-			}
+void dashboard_pi::StopDecodeThread(void) {
+	if (m_pDecodeThread != NULL) {
+		m_decoderExit = true;
+		m_ingestSignal.Post();
+		m_pDecodeThread->Wait();
+		delete m_pDecodeThread;
+		m_pDecodeThread = NULL;
+	}
 
-			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
-			}
+	// Discard any values that have yet to be displayed
+	while (m_decodedQueue.Front() != NULL) {
+		m_decodedQueue.Pop();
+	}
+}
 
-			if (update_path == _T("propulsion.starboard.exhaustTemperature")) {
-				// dualEngine = TRUE;
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
-			}
-		}
-		else if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-			if ((update_path == _T("propulsion.port.temperature")) && (!dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
-			}
+// Invoked on the UI thread whenever the preferences used by the decoders are loaded or changed
+void dashboard_pi::PublishDecoderSettings(void) {
+	DecoderSettings settings;
+	settings.temperatureUnit = g_iDashTemperatureUnit;
+	settings.pressureUnit = g_iDashPressureUnit;
+	settings.dualEngine = dualEngine;
+	m_decoder.PublishSettings(settings);
+}
 
-			if ((update_path == _T("propulsion.port.temperature")) && (dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
-			}
+// A second engine instance makes this a dual engine vessel. When invoked from the decode thread,
+// the preference is updated by the UI thread, which then publishes it back to the decoder.
+void dashboard_pi::OnDualEngineDetected(void) {
+	if (wxThread::IsMain()) {
+		dualEngine = true;
+		PublishDecoderSettings();
+	}
+	else {
+		wxQueueEvent(this, new wxThreadEvent(wxEVT_THREAD, DECODE_EVENT_DUAL_ENGINE));
+	}
+}
 
-			if (update_path == _T("propulsion.starboard.temperature")) {
-				// dualEngine = TRUE;
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
-			}
+void dashboard_pi::Enqueue(IngestType type, const wxString &sentence) {
+	IngestItem *item = ReserveIngestItem(m_ingestQueue, type, sentence);
+	if (item == NULL) {
+		// Queue is full, the payload is counted as dropped
+		return;
+	}
 
-			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (!dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
-			}
+	if (m_pDecodeThread == NULL) {
+		// No decode thread, so decode synchronously
+		m_decoder.DecodeItem(*item);
+		return;
+	}
 
-			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (dualEngine)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
-			}
+	m_ingestQueue.Push();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_decoderIdle.exchange(false)) {
+		m_ingestSignal.Post();
+	}
+}
 
-			if (update_path == _T("propulsion.starboard.exhaustTemperature")) {
-				// dualEngine = TRUE;
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
-			}
-		}
-		// Units are in seconds
-		if ((update_path == _T("propulsion.port.runTime")) && (!dualEngine)) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, value.AsInt() / 3600.0, "Hrs");
-		}
+void dashboard_pi::Enqueue(IngestType type, const std::vector<uint8_t> &payload) {
+	IngestItem *item = ReserveIngestItem(m_ingestQueue, type, payload);
+	if (item == NULL) {
+		return;
+	}
 
-		if ((update_path == _T("propulsion.port.runTime")) && (dualEngine)) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, value.AsInt() / 3600.0, "Hrs");
-		}
+	if (m_pDecodeThread == NULL) {
+		m_decoder.DecodeItem(*item);
+		return;
+	}
 
-		if (update_path == _T("propulsion.starboard.runTime")) {
-			// dualEngine = TRUE;
-			SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, value.AsInt() / 3600.0, "Hrs");
-		}
+	m_ingestQueue.Push();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_decoderIdle.exchange(false)) {
+		m_ingestSignal.Post();
+	}
+}
 
-		if (update_path == _T("electrical.batteries.0.voltage")) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, GetJsonDouble(value), "Volts");
-		}
+void dashboard_pi::DecodeIngestQueue(void) {
+	IngestItem *item;
+	while ((item = m_ingestQueue.Front()) != NULL) {
+		m_decoder.DecodeItem(*item);
+		m_ingestQueue.Pop();
+	}
+}
 
-		if (update_path == _T("electrical.batteries.0.current")) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, GetJsonDouble(value), "Amps");
-		}
+// Enabled by setting Diagnostics=1 in the [PlugIns/Engine-Dashboard] section of the config file
+void dashboard_pi::LogDiagnostics(void) {
+	wxLogMessage(_T("Engine Dashboard, Ingest Queue: %lu/%lu, Dropped: %lu, Decoded Queue: %lu/%lu, Dropped: %lu"),
+		(unsigned long)m_ingestQueue.GetDepth(), (unsigned long)m_ingestQueue.GetCapacity(), m_ingestQueue.GetDropped(),
+		(unsigned long)m_decodedQueue.GetDepth(), (unsigned long)m_decodedQueue.GetCapacity(), m_decodedQueue.GetDropped());
 
-		if (update_path == _T("electrical.batteries.1.voltage")) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, GetJsonDouble(value), "Volts");
+	wxLongLong now = wxGetLocalTimeMillis();
+	for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
+		DashboardWindow *dashboard_window = m_ArrayOfDashboardWindow.Item(i)->m_pDashboardWindow;
+		if (dashboard_window == NULL) {
+			continue;
 		}
-
-		if (update_path == _T("electrical.batteries.1.current")) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, GetJsonDouble(value), "Amps");
+		// Frame cost, either of the composited frame or the sum of the instrument paints,
+		// so that the two rendering modes may be compared for the same layout
+		double frameCost = 0;
+		for (size_t j = 0; j < dashboard_window->GetInstrumentCount(); j++) {
+			DashboardInstrument *instrument = dashboard_window->GetInstrument(j);
+			wxLogMessage(_T("Engine Dashboard, %s, Refresh: %.1f Hz, Target: %.1f Hz, Paint: %.2f ms"),
+				instrument->GetCaption(), instrument->GetActualRate(now),
+				1000.0 / instrument->GetTargetInterval(), instrument->GetPaintCost());
+			frameCost += instrument->GetPaintCost();
 		}
-
-		if (update_path.StartsWith(_T("steering.rudderAngle"))) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, RADIANS_TO_DEGREES(GetJsonDouble(value)), _T("\u00B0"));
+		if (dashboard_window->IsComposite()) {
+			frameCost = dashboard_window->GetFrameCost();
 		}
+		wxLogMessage(_T("Engine Dashboard, %s, %s Rendering, Instruments: %lu, Frame: %.2f ms"),
+			m_ArrayOfDashboardWindow.Item(i)->m_sCaption, dashboard_window->IsComposite() ? _T("Composite") : _T("Window"),
+			(unsigned long)dashboard_window->GetInstrumentCount(), frameCost);
+	}
 
-		// Engine Warning state = "alarm" or "normal"
-		if (update_path.StartsWith("notifications.propulsion", NULL)) {
-			// Status One Alarm conditions
-			// Main Engine
-			// Bit 0
-			if ((update_path == "notifications.propulsion.port.checkEngine") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 1, wxEmptyString);
-				}
-			}
-			// Bit 1
-			if ((update_path == "notifications.propulsion.port.overTemperature") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 2, wxEmptyString);
-				}
-			}
-			// Bit 2
-			if ((update_path == "notifications.propulsion.port.lowOilPressure") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 4, wxEmptyString);
-				}
-			}
-			// Bit 3
-			if ((update_path == "notifications.propulsion.port.lowOilLevel") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 8, wxEmptyString);
-				}
-			}
-			// Bit 4
-			if ((update_path == "notifications.propulsion.port.lowFuelPressure") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 16, wxEmptyString);
-				}
-			}
-			// Bit 5
-			if ((update_path == "notifications.propulsion.port.lowSystemVoltage") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 32, wxEmptyString);
-				}
-			}
-			// Bit 6
-			if ((update_path == "notifications.propulsion.port.lowCoolantLevel") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 64, wxEmptyString);
-				}
-			}
-			// Bit 7
-			if ((update_path == "notifications.propulsion.port.waterFlow") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 128, wxEmptyString);
-				}
-			}
-			// Bit 8
-			if ((update_path == "notifications.propulsion.port.waterInFuel") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 256, wxEmptyString);
-				}
-			}
-			// Bit 9
-			if ((update_path == "notifications.propulsion.port.chargeIndicator") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 512, wxEmptyString);
-				}
-			}
-			// Bit 10
-			if ((update_path == "notifications.propulsion.port.preheatIndicator") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 1024, wxEmptyString);
-				}
-			}
-			// Bit 11
-			if ((update_path == "notifications.propulsion.port.highBoostPressure") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 2048, wxEmptyString);
-				}
-			}
-			// Bit 12
-			if ((update_path == "notifications.propulsion.port.revLimitExceeded") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 4096, wxEmptyString);
-				}
-			}
-			// Bit 13
-			if ((update_path == "notifications.propulsion.port.eGRSystem") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 8192, wxEmptyString);
-				}
-			}
-			// Bit 14
-			if ((update_path == "notifications.propulsion.port.throttlePositionSensor") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 16384, wxEmptyString);
-				}
-			}
-			//Bit 15
-			if ((update_path == "notifications.propulsion.port.emergencyStopMode") && (!dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 32768, wxEmptyString);
-				}
-			}
-			// Port Engine
-			// Bit 0
-			if ((update_path == "notifications.propulsion.port.checkEngine") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 1, wxEmptyString);
-				}
-			}
-			// Bit 1
-			if ((update_path == "notifications.propulsion.port.overTemperature") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 2, wxEmptyString);
-				}
-			}
-			// Bit 2
-			if ((update_path == "notifications.propulsion.port.lowOilPressure") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 4, wxEmptyString);
-				}
-			}
-			// Bit 3
-			if ((update_path == "notifications.propulsion.port.lowOilLevel") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 8, wxEmptyString);
-				}
-			}
-			// Bit 4
-			if ((update_path == "notifications.propulsion.port.lowFuelPressure") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 16, wxEmptyString);
-				}
-			}
-			// Bit 5
-			if ((update_path == "notifications.propulsion.port.lowSystemVoltage") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 32, wxEmptyString);
-				}
-			}
-			// Bit 6
-			if ((update_path == "notifications.propulsion.port.lowCoolantLevel") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 64, wxEmptyString);
-				}
-			}
-			// Bit 7
-			if ((update_path == "notifications.propulsion.port.waterFlow") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 128, wxEmptyString);
-				}
-			}
-			// Bit 8
-			if ((update_path == "notifications.propulsion.port.waterInFuel") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 256, wxEmptyString);
-				}
-			}
-			// Bit 9
-			if ((update_path == "notifications.propulsion.port.chargeIndicator") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 512, wxEmptyString);
-				}
-			}
-			// Bit 10
-			if ((update_path == "notifications.propulsion.port.preheatIndicator") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 1024, wxEmptyString);
-				}
-			}
-			// Bit 11
-			if ((update_path == "notifications.propulsion.port.highBoostPressure") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 2048, wxEmptyString);
-				}
-			}
-			// Bit 12
-			if ((update_path == "notifications.propulsion.port.revLimitExceeded") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 4096, wxEmptyString);
-				}
-			}
-			// Bit 13
-			if ((update_path == "notifications.propulsion.port.eGRSystem") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 8192, wxEmptyString);
-				}
-			}
-			// Bit 14
-			if ((update_path == "notifications.propulsion.port.throttlePositionSensor") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 16384, wxEmptyString);
-				}
-			}
-			//Bit 15
-			if ((update_path == "notifications.propulsion.port.emergencyStopMode") && (dualEngine)) {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 32768, wxEmptyString);
-				}
-			}
-
-			// Starboard Engine
-			// Bit 0
-			if (update_path == "notifications.propulsion.starboard.checkEngine") {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 1, wxEmptyString);
-				}
-			}
-			// Bit 1
-			if (update_path == "notifications.propulsion.starboard.overTemperature")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 2, wxEmptyString);
-				}
-			}
-			// Bit 2
-			if (update_path == "notifications.propulsion.starboard.lowOilPressure")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 4, wxEmptyString);
-				}
-			}
-			// Bit 3
-			if (update_path == "notifications.propulsion.starboard.lowOilLevel")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 8, wxEmptyString);
-				}
-			}
-			// Bit 4
-			if (update_path == "notifications.propulsion.starboard.lowFuelPressure")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 16, wxEmptyString);
-				}
-			}
-			// Bit 5
-			if (update_path == "notifications.propulsion.starboard.lowSystemVoltage")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 32, wxEmptyString);
-				}
-			}
-			// Bit 6
-			if (update_path == "notifications.propulsion.starboard.lowCoolantLevel")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 64, wxEmptyString);
-				}
-			}
-			// Bit 7
-			if (update_path == "notifications.propulsion.starboard.waterFlow")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 128, wxEmptyString);
-				}
-			}
-			// Bit 8
-			if (update_path == "notifications.propulsion.starboard.waterInFuel")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 256, wxEmptyString);
-				}
-			}
-			// Bit 9
-			if (update_path == "notifications.propulsion.starboard.chargeIndicator")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 512, wxEmptyString);
-				}
-			}
-			// Bit 10
-			if (update_path == "notifications.propulsion.starboard.preheatIndicator")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 1024, wxEmptyString);
-				}
-			}
-			// Bit 11
-			if (update_path == "notifications.propulsion.starboard.highBoostPressure")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 2048, wxEmptyString);
-				}
-			}
-			// Bit 12
-			if (update_path == "notifications.propulsion.starboard.revLimitExceeded")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 4096, wxEmptyString);
-				}
-			}
-			// Bit 13
-			if (update_path == "notifications.propulsion.starboard.eGRSystem")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 8192, wxEmptyString);
-				}
-			}
-			// Bit 14
-			if (update_path == "notifications.propulsion.starboard.throttlePositionSensor")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 16384, wxEmptyString);
-				}
-			}
-			//Bit 15
-			if (update_path == "notifications.propulsion.starboard.emergencyStopMode")  {
-				if (CheckAlarmState(value)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 32768, wxEmptyString);
-				}
-			}
-			/////////////////
-
-			// Status Two Error Codes
-			// Currently Don't have icons for these, nor do I handle these in native NMEA 2000
-			// Bit 0
-			if (update_path == "notifications.propulsion.port.warningLevel1") {
-
-			} 
-			// Bit 1
-			if (update_path == "notifications.propulsion.port.warningLevel2") {
-
-			} 
-			// Bit 2
-			if (update_path == "notifications.propulsion.port.powerReduction") {
-
-			} 
-			// Bit 3
-			if (update_path == "notifications.propulsion.port.maintenanceNeeded") {
-
-			} 
-			// Bit 4
-			if (update_path == "notifications.propulsion.port.commError") {
-
-			} 
-			// Bit 5
-			if (update_path == "notifications.propulsion.port.subOrSecondaryThrottle") {
-
-			} 
-			// Bit 6
-			if (update_path == "notifications.propulsion.port.neutralStartProtect") {
-
-			} 
-			// Bit 7
-			if (update_path == "notifications.propulsion.port.shuttingDown") {
-
-			}
-		}
-
-		// Fluid Levels
-		if (update_path.StartsWith("tanks", NULL)) {
-			tankLevelWatchDog = wxDateTime::Now();
-			wxString xdrunit = "Level";
-
-			// Units are meant to be in percent, but they seem to range from 0 to 1
-			if (update_path == _T("tanks.freshWater.0.currentLevel")) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, GetJsonDouble(value) * 100, xdrunit);
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, GetJsonDouble(value) * 100, xdrunit);
-			}
-
-			if (update_path == _T("tanks.freshWater.1.currentLevel")) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, GetJsonDouble(value) * 100, xdrunit);
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, GetJsonDouble(value) * 100, xdrunit);
-			}
-
-			if (update_path == _T("tanks.freshWater.2.currentLevel")) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, GetJsonDouble(value) * 100, xdrunit);
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, GetJsonDouble(value) * 100, xdrunit);
-			}
-
-			if (update_path == _T("tanks.wasteWater.0.currentLevel")) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, GetJsonDouble(value) * 100, xdrunit);
-			}
-
-			if (update_path == _T("tanks.blackWater.0.currentLevel")) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, GetJsonDouble(value) * 100, xdrunit);
-			}
-
-			if (update_path == _T("tanks.fuel.0.currentLevel")) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, GetJsonDouble(value) * 100, xdrunit);
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, GetJsonDouble(value) * 100, xdrunit);
-			}
+	wxLogMessage(_T("Engine Dashboard, Back-buffers: %d, Memory: %.1f KB"),
+		GetBackBufferCount(), GetBackBufferMemory() / 1024.0);
 
-			if (update_path == _T("tanks.fuel.1.currentLevel")) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, GetJsonDouble(value) * 100, xdrunit);
-				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, GetJsonDouble(value) * 100, xdrunit);
-			}
-		}
-	}
+	wxLogMessage(_T("Engine Dashboard, Quality: %s, Frame: %.2f ms, Budget: %.2f ms"),
+		GetRenderQualityName(GetRenderQuality()), m_frameTime, m_frameBudget);
 }
 
-// SignalK Engine Notifications
-// "state": "normal | alarm"
-// "method: ["visual", "sound"]
-// "message": "Port Enngine Charge Indicator is normal"
-bool dashboard_pi::CheckAlarmState(wxJSONValue& value) {
-	if (value.HasMember("state")) {
-		if (value["state"].AsString() == "alarm") {
-			return true;
-		}
+// Receive & handle SignalK derived data
+void dashboard_pi::SetPluginMessage(wxString& message_id, wxString& message_body) {
+	if (message_id == _T("OCPN_CORE_SIGNALK")) {
+		Enqueue(INGEST_SIGNALK, message_body);
 	}
-	return false;
 }
 
 void dashboard_pi::HandleXDR(ObservedEvt ev) {
 	NMEA0183Id id_183_xdr("XDR");
 
-	wxString sentence(GetN0183Payload(id_183_xdr, ev));
-	m_NMEA0183 << sentence;
-
-	// Handle NMEA 0183 XDR sentences
-	// These are the specific XDR sentences sent by the TwoCan Plugin
-	// XDR Transducer Description		Type	Units
-	// Temperature Transducer			C		C (degrees Celsius)
-	// Pressure Transducer				P		P (Pascal)
-	// Tachometer Transducer			T		R (RPM)
-	// Volume Transducer				V		P (percent capacity) rather than M (cubic metres)
-	// Voltage Transducer				U		V (volts) (for Battery Status, A = Amps)
-	// Generic Transducer				G		H (hours, I use this to display engine hours)
-	// Switch (Not yet implemented)		S		(no units), Names customised for Status 1 & 2 codes 
-
-	if (m_NMEA0183.Parse()) {
-		wxString xdrunit;
-		double xdrdata;
-		// Each NMEA 0183 XDR sentence may have up to 4 items
-		for (int i = 0; i < m_NMEA0183.Xdr.TransducerCnt; i++) {
-			// Copy the NMEA 183 XDR Sentence data element to a variable
-			xdrdata = m_NMEA0183.Xdr.TransducerInfo[i].MeasurementData;
-
-			// Now for each sentence, parse the transducer type, name and units  to determine which gauge to send the data to
-
-			// "T" Engine RPM in unit "R" RPM
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("T")) {
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("R")) {
-					// Update Watchdog timer
-					engineWatchDog = wxDateTime::Now();
-					// Set the units
-					xdrunit = _T("RPM");
-					// TwoCan plugin transducer names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					// NMEA 183 v4.11 transducer names
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					// Ship Modul/Maretron transducer names
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE0")) && (!dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE0")) && (dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, xdrdata, xdrunit);
-					}
-				}
-			}
-
-			// "C" Temperature in "C" degrees Celsius
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("C")) {
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("C")) {
-					if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-						xdrunit = _T("\u00B0 C");
-						// TwoCan transducer naming
-						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						// NMEA 183 v4.11 Transducer Names
-						// Engine Temperature
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						// Engine Exhaust
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, xdrdata, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, xdrdata, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, xdrdata, xdrunit);
-						}
-						// Ship Modul/Maretron Transducer Names
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, xdrdata, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, xdrdata, xdrunit);
-						}
-					}
-					else if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-						xdrunit = _T("\u00B0 F");
-						// TwoCan Transducer naming 
-						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						// NMEA 183 v4.11 Transducer Names
-						// Engine Temperature
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						// Exhaust Temperature
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						// Ship Modul/Maretron Transducer Names
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
-						}
-					}
-				}
-			}
-
-			// "P" Pressure in "P" pascal
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("P")) {
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("P")) {
-					if (g_iDashPressureUnit == PRESSURE_BAR) {
-						xdrunit = _T("Bar");
-						// TwoCan Transducer naming
-						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						// NMEA 183 v4.11 Transducer Names
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						// Ship Modul/Maretron Transducer Names
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
-						}
-
-					}
-					else if (g_iDashPressureUnit == PRESSURE_PSI) {
-						xdrunit = _T("PSI");
-						// TwoCan Plugin Transducer Names
-						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						// NMEA 183 v4.11 Transducer Names
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						// Ship Modul/MaretronTransducer Names
-						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP1")) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (!dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (dualEngine)) {
-							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
-						}
-					}
-				}
-			}
-
-			// "U" Voltage in "V" volts
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("U")) {
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("V")) {
-					xdrunit = _T("Volts");
-					// TwoCan Plugin Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STRT")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("HOUS")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, xdrdata, xdrunit);
-					}
-					// NMEA 183 v4.11 Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTERNATOR#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTERNATOR#0")) && (!dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTERNATOR#0")) && (dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, xdrdata, xdrunit);
-					}
-					// Ship Modul/Maretron Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTVOLT1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTVOLT0")) && (!dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTVOLT0")) && (dualEngine)) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATVOLT0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATVOLT1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, xdrdata, xdrunit);
-					}
-				}
-				// TwoCan also uses "A" to indicate battery current
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("A")) {
-					xdrunit = _T("Amps");
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STRT")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("HOUS")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, xdrdata, xdrunit);
-					}
-				}
-			}
-
-			// NMEA 0183 V4 standard for current
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("I")) {
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("A")) {
-					xdrunit = _T("Amps");
-					// NMEA 183 v4.11 Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, xdrdata, xdrunit);
-					}
-					// Ship Modul/Maretron Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATCURR0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATCURR1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, xdrdata, xdrunit);
-					}
-				}
-			}
-
-			// "G" Generic - Customised to use "H" as engine hours
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("G")) {
-				// TwoCan uses "H" as unit of measurement 
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("H")) {
-					xdrunit = _T("Hrs");
-					// TwoCan Plugin transducer naming
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
-						mainEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
-						portEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
-						stbdEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-				}
-				// NMEA 183 v4.11 Transducer Names, Note lack of clarity re transducer names
-				// Note does not have a unit of measurement
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == wxEmptyString) {
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
-						xdrunit = _T("Hrs");
-						stbdEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!dualEngine)) {
-						xdrunit = _T("Hrs");
-						mainEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (dualEngine)) {
-						xdrunit = _T("Hrs");
-						portEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-				}
-				// NMEA 183 v4.11 Yacht Devices appear to use EngineHours
-				// Note does not have a unit of measurement
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == wxEmptyString) {
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEHOURS#1")) {
-						xdrunit = _T("Hrs");
-						stbdEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEHOURS#0")) && (!dualEngine)) {
-						xdrunit = _T("Hrs");
-						mainEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEHOURS#0")) && (dualEngine)) {
-						xdrunit = _T("Hrs");
-						portEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-				}
-				// Ship Modul/Maretron Transducer Names 
-				// Note does not have a unit of measurement
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == wxEmptyString) {
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGHRS1")) {
-						xdrunit = _T("Hrs");
-						stbdEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGHRS0")) && (!dualEngine)) {
-						xdrunit = _T("Hrs");
-						mainEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGHRS0")) && (dualEngine)) {
-						xdrunit = _T("Hrs");
-						portEngineHours = xdrdata;
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
-					}
-				}
-
-			}
-
-			// "V" Volume - Customised to use "P" as percent capacity
-			// instead of "M" as volume in cubic metres
-			// Note that NMEA 183 v4.11 standard now introduces 'P' as percent capacity
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("V")) {
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("P")) {
-					// Update Watchdog Timer
-					tankLevelWatchDog = wxDateTime::Now();
-					xdrunit = _T("Level");
-					// TwoCan Plugin Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("FUEL")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("H2O")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("OIL")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("LIVE")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("GREY")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("BLACK")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
-					}
-					// NMEA 183 v4.11 Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
-					}
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#2")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("OIL#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("LIVEWELLWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("WASTEWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BLACKWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
-					}
-				}
-			}
-			// NMEA 0184 v4.11 Standard for volume with percentage capacity
-			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("E")) {
-				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("P")) {
-					// Update Watchdog Timer
-					tankLevelWatchDog = wxDateTime::Now();
-					xdrunit = _T("Level");
-					// NMEA 183 v4.11 Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
-					}
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#2")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("OIL#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("LIVEWELLWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("WASTEWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BLACKWATER#0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
-					}
-					// Ship Modul/Martron Transducer Names
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
-					}
-					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER1")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER2")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, xdrdata, xdrunit);
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("OIL0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("LIVEWELL0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("WASTEWATER0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
-					}
-					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BLACKWATER0")) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
-					}
-				}
-			}
-		}
-	}
+	Enqueue(INGEST_NMEA0183_XDR, wxString(GetN0183Payload(id_183_xdr, ev)));
 }
 
 void dashboard_pi::HandleRPM(ObservedEvt ev) {
 	NMEA0183Id id_183_rpm("RPM");
 
-	wxString sentence(GetN0183Payload(id_183_rpm, ev));
-	m_NMEA0183 << sentence;
-
-	if (m_NMEA0183.Parse()) {
-		if (m_NMEA0183.Rpm.IsDataValid == NTrue) {
-			// Only display engine rpm 'E', not shaft rpm 'S'
-			if (m_NMEA0183.Rpm.Source == _T("E")) {
-				// Update Watchdog Timer
-				engineWatchDog = wxDateTime::Now();
-				// Engine Numbering: 
-				// 0 = Mid-line, Odd = Starboard, Even = Port (numbered from midline)
-				switch (m_NMEA0183.Rpm.EngineNumber) {
-				case 0:
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
-					break;
-				case 1:
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
-					break;
-				case 2:
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
-					break;
-				default:
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
-					break;
-				}
-			}
-		}
-	}
+	Enqueue(INGEST_NMEA0183_RPM, wxString(GetN0183Payload(id_183_rpm, ev)));
 }
 
 void dashboard_pi::HandleRSA(ObservedEvt ev) {
 	NMEA0183Id id_183_rsa("RSA");
 
-	wxString sentence(GetN0183Payload(id_183_rsa, ev));
-	m_NMEA0183 << sentence;
-
-	// Plugin does not differentiate dual rudders (port/starboard)
-
-	if (m_NMEA0183.Parse()) {
-		if (m_NMEA0183.Rsa.IsStarboardDataValid == NTrue) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, m_NMEA0183.Rsa.Starboard, _T("\u00B0"));
-		}
-		else if (m_NMEA0183.Rsa.IsPortDataValid == NTrue) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, m_NMEA0183.Rsa.Port, _T("\u00B0"));
-		}
-	}
+	Enqueue(INGEST_NMEA0183_RSA, wxString(GetN0183Payload(id_183_rsa, ev)));
 }
 
 // BUG BUG Core OpenCPN has yet to implement the GetSignalKPayload function
@@ -1809,427 +1008,40 @@ void dashboard_pi::HandleSignalK(ObservedEvt ev) {
 }
 
 
-// Raw NMEA 2000 generated by OpenCPN v5.8
-// Parsing routines cut and pasted from TwoCan Plugin
-// Refer to twocandevice.cpp
-
-// Note the payload is not "the payload" but an entire Actisense payload
-// Actisense application data, from NGT-1 to PC
-// <data code=93><length (1)><priority (1)><PGN (3)><destination(1)><source
-// (1)><time (4)><len (1)><data (len)>
-
-// As applied to a real application data element, after extraction from packet
-// format: 93 13 02 01 F8 01 FF 01 76 C2 52 00 08 08 70 EB 14 E8 8E 52 D2 BB 10
-
-// data code		0x93
-// length (1):      0x13
-// priority (1);    0x02
-// PGN (3):         0x01 0xF8 0x01
-// destination(1):  0xFF
-// source (1):      0x01
-// time (4):        0x76 0xC2 0x52 0x00
-// len (1):         0x08
-// data (len):      08 70 EB 14 E8 8E 52 D2
-// packet CRC:      0xBB
-
-// So to simplify parsing as these are copied from twocan plugin, 
-// use an index into the "real" payload at byte 13 
-
 // PGN 127488 Engine Rapid Update
 void dashboard_pi::HandleN2K_127488(ObservedEvt ev) {
 	NMEA2000Id id_127488(127488);
-	std::vector<uint8_t>payload = GetN2000Payload(id_127488, ev);
-
-	byte engineInstance;
-	engineInstance = payload[index + 0];
-
-	unsigned short engineSpeed; // RPM in quarter revolutions per minute
-	engineSpeed = payload[index + 1] | (payload[index + 2] << 8);
-
-	unsigned short engineBoostPressure;
-	engineBoostPressure = payload[index + 3] | (payload[index + 4] << 8);
-
-	short engineTrim;
-	engineTrim = payload[index + 5];
-
-	if (engineInstance > 0) {
-		dualEngine = TRUE;
-	}
-
-	engineWatchDog = wxDateTime::Now();
-
-	if (IsDataValid(engineSpeed)) {
-		switch (engineInstance) {
-			case 0:
-				if (dualEngine) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, engineSpeed * 0.25f, "RPM");
-				}
-				else {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, engineSpeed * 0.25f, "RPM");
-				}
-				break;
-			case 1:
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, engineSpeed * 0.25f, "RPM");
-				break;
-		}
-	}
+	Enqueue(INGEST_N2K_127488, GetN2000Payload(id_127488, ev));
 }
 
 // PGN 127489 Engine Dynamic 
 void dashboard_pi::HandleN2K_127489(ObservedEvt ev) {
 	NMEA2000Id id_127489(127489);
-	std::vector<uint8_t>payload = GetN2000Payload(id_127489, ev);
-
-	byte engineInstance;
-	engineInstance = payload[index + 0];
-
-	unsigned short oilPressure; // hPa (1 hPa = 100Pa, 1 hPa = .001 Bar)
-	oilPressure = payload[index + 1] | (payload[index + 2] << 8);
-
-	unsigned short oilTemperature; // 0.01 degree resolution, in Kelvin
-	oilTemperature = payload[index + 3] | (payload[index + 4] << 8);
-
-	unsigned short engineTemperature; // 0.01 degree resolution, in Kelvin
-	engineTemperature = payload[index + 5] | (payload[index + 6] << 8);
-
-	unsigned short alternatorPotential; // 0.01 Volts
-	alternatorPotential = payload[index + 7] | (payload[index + 8] << 8);
-
-	unsigned short fuelRate; // 0.1 Litres/hour
-	fuelRate = payload[index + 9] | (payload[index + 10] << 8);
-
-	unsigned int totalEngineHours;  // seconds
-	totalEngineHours = payload[index + 11] | (payload[index + 12] << 8) | (payload[index + 13] << 16) | (payload[index + 14] << 24);
-
-	unsigned short coolantPressure; // hPA
-	coolantPressure = payload[index + 15] | (payload[index + 16] << 8);
-
-	unsigned short fuelPressure; // hPa
-	fuelPressure = payload[index + 17] | (payload[index + 18] << 8);
-
-	unsigned short reserved;
-	reserved = payload[index + 19];
-
-	unsigned short statusOne;
-	statusOne = payload[index + 20] | (payload[index + 21] << 8);
-	// Refer to dial.cpp for which SVG images match fault conditions
-	// {"0": "Check Engine"},
-	// { "1": "Over Temperature" },
-	// { "2": "Low Oil Pressure" },
-	// { "3": "Low Oil Level" },
-	// { "4": "Low Fuel Pressure" },
-	// { "5": "Low System Voltage" },
-	// { "6": "Low Coolant Level" },
-	// { "7": "Water Flow" },
-	// { "8": "Water In Fuel" },
-	// { "9": "Charge Indicator" },
-	// { "10": "Preheat Indicator" },
-	// { "11": "High Boost Pressure" },
-	// { "12": "Rev Limit Exceeded" },
-	// { "13": "EGR System" },
-	// { "14": "Throttle Position Sensor" },
-	// { "15": "Emergency Stop" }]
-
-	unsigned short statusTwo;
-	statusTwo = payload[index + 22] | (payload[index + 23] << 8);
-
-	// {"0": "Warning Level 1"},
-	// { "1": "Warning Level 2" },
-	// { "2": "Power Reduction" },
-	// { "3": "Maintenance Needed" },
-	// { "4": "Engine Comm Error" },
-	// { "5": "Sub or Secondary Throttle" },
-	// { "6": "Neutral Start Protect" },
-	// { "7": "Engine Shutting Down" }]
-
-	byte engineLoad;  // percentage
-	engineLoad = payload[index + 24];
-
-	byte engineTorque; // percentage
-	engineTorque = payload[index + 25];
-
-	if (engineInstance > 0) {
-		dualEngine = TRUE;
-	}
-
-	switch (engineInstance) {
-		case 0:
-			if (dualEngine) {
-				if (IsDataValid(oilPressure)) {
-					if (g_iDashPressureUnit == PRESSURE_BAR) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, oilPressure * 1e-3, "Bar");
-					}
-					if (g_iDashPressureUnit == PRESSURE_PSI) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(oilPressure * 100), "Psi");
-					}
-				}
-
-				if (IsDataValid(engineTemperature)) {
-					if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, CONVERT_KELVIN((engineTemperature * 0.01f)), _T("\u00B0 C"));
-					}
-					if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN((engineTemperature * 0.01f))), _T("\u00B0 F"));
-					}
-				}
-			
-				if (IsDataValid(alternatorPotential)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, alternatorPotential * 0.01, "Volts");
-				}
-
-				if (IsDataValid(totalEngineHours)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, totalEngineHours / 3600.0, "Hrs");
-				}
-
-				if (statusOne !=0) {
-					wxLogMessage("XXXXXXXX Engine Status: %d", statusOne);
-					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, statusOne, wxEmptyString);
-				}
-			}
-			else {
-				if (IsDataValid(oilPressure)) {
-					if (g_iDashPressureUnit == PRESSURE_BAR) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, oilPressure * 1e-3, "Bar");
-					}
-					if (g_iDashPressureUnit == PRESSURE_PSI) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(oilPressure  * 100), "Psi");
-					}
-				}
-				if (IsDataValid(engineTemperature)) {
-					if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, CONVERT_KELVIN((engineTemperature * 0.01f)), _T("\u00B0 C"));
-					}
-					if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN((engineTemperature * 0.01f))), _T("\u00B0 F"));
-					}
-				}
-
-				if (IsDataValid(alternatorPotential)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, alternatorPotential * 0.01, "Volts");
-				}
-
-				if (IsDataValid(totalEngineHours)) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, totalEngineHours / 3600.0, "Hrs");
-				}
-
-				if (statusOne != 0) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, statusOne, wxEmptyString);
-				}
-			}
-			break;
-		case 1:
-			if (IsDataValid(oilPressure)) {
-				if (g_iDashPressureUnit == PRESSURE_BAR) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, oilPressure * 1e-3, "Bar");
-				}
-				if (g_iDashPressureUnit == PRESSURE_PSI) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(oilPressure * 100), "Psi");
-				}
-			}
-			if (IsDataValid(engineTemperature)) {
-				if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, CONVERT_KELVIN((engineTemperature * 0.01f)), _T("\u00B0 C"));
-				}
-				if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit((CONVERT_KELVIN(engineTemperature * 0.01f))), _T("\u00B0 F"));
-				}
-			}
-
-			if (IsDataValid(alternatorPotential)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, alternatorPotential * 0.01, "Volts");
-			}
-
-			if (IsDataValid(totalEngineHours)) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, totalEngineHours / 3600.0, "Hrs");
-			}
-
-			if (statusOne != 0) {
-				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, statusOne, wxEmptyString);
-			}
-
-			break;
-		}
+	Enqueue(INGEST_N2K_127489, GetN2000Payload(id_127489, ev));
 }
 
 // PGN 127505 Fluid Levels
 void dashboard_pi::HandleN2K_127505(ObservedEvt ev) {
 	NMEA2000Id id_127505(127505);
-	std::vector<uint8_t>payload = GetN2000Payload(id_127505, ev);
-
-	byte instance;
-	instance = payload[index + 0] & 0x0F;
-
-	byte tankType;
-	tankType = (payload[index + 0] & 0xF0) >> 4;
-
-	unsigned short tankLevel; // percentage in 0.025 increments
-	tankLevel = payload[index + 1] | (payload[index + 2] << 8);
-
-	unsigned int tankCapacity; // 0.1 L
-	tankCapacity = payload[index + 3] | (payload[index + 4] << 8) | (payload[index + 5] << 16) | (payload[index + 6] << 24);
-
-	tankLevelWatchDog = wxDateTime::Now();
-
-	if (IsDataValid(tankLevel)) {
-
-		switch (tankType) {
-			case 0: // Fuel
-				if (instance == 0) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, tankLevel / 250, "Level");
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, tankLevel / 250, "Level");
-				}
-				if (instance == 1) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, tankLevel / 250, "Level");
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, tankLevel / 250, "Level");
-				}
-				break;
-			case 1: // Freshwater
-				if (instance == 0) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, tankLevel / 250, "Level");
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, tankLevel / 250, "Level");
-				}
-				if (instance == 1) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, tankLevel / 250, "Level");
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, tankLevel / 250, "Level");
-				}
-				if (instance == 2) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, tankLevel / 250, "Level");
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, tankLevel / 250, "Level");
-				}
-				break;
-			case 2: // Waste water
-				if (instance == 0) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, tankLevel / 250, "Level");
-				}
-				break;
-			case 4: // Oil
-				if (instance == 0) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, tankLevel / 250, "Level");
-				}
-				break;
-			case 5: // Blackwater
-				if (instance == 0) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, tankLevel / 250, "Level");
-				}
-				break;
-			}
-	}
+	Enqueue(INGEST_N2K_127505, GetN2000Payload(id_127505, ev));
 }
 
 // PGN 127508 Battery Status
 void dashboard_pi::HandleN2K_127508(ObservedEvt ev) {
 	NMEA2000Id id_127508(127508);
-	std::vector<uint8_t>payload = GetN2000Payload(id_127508, ev);
-
-	byte batteryInstance;
-	batteryInstance = payload[index + 0];
-
-	unsigned short batteryVoltage; // 0.01 volts
-	batteryVoltage = payload[index + 1] | (payload[index + 2] << 8);
-
-	short batteryCurrent; // 0.1 amps	
-	batteryCurrent = payload[index + 3] | (payload[index + 4] << 8);
-
-	unsigned short batteryTemperature; // 0.01 degree resolution, in Kelvin
-	batteryTemperature = payload[index + 5] | (payload[index + 6] << 8);
-
-	byte sid;
-	sid = payload[index + 7];
-
-	if ((IsDataValid(batteryVoltage)) && (IsDataValid(batteryCurrent))) {
-
-		if (batteryInstance == 0) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, batteryVoltage * 0.01f, "Volts");
-			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, batteryCurrent * 0.1f, "Amps");
-		}
-
-		if (batteryInstance == 1) {
-			SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, batteryVoltage * 0.01f, "Volts");
-			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, batteryCurrent * 0.1f, "Amps");
-		}
-	}
-	
+	Enqueue(INGEST_N2K_127508, GetN2000Payload(id_127508, ev));
 }
 
 // PGN 130312 Temperature (used for Exhaust Gas Temperature)
 void dashboard_pi::HandleN2K_130312(ObservedEvt ev) {
 	NMEA2000Id id_130312(130312);
-	std::vector<uint8_t>payload = GetN2000Payload(id_130312, ev);
-
-	byte sid;
-	sid = payload[index + 0];
-
-	byte engineInstance;
-	engineInstance = payload[index + 1];
-
-	byte source;
-	source = payload[index + 2];
-
-	unsigned short actualTemperature;
-	actualTemperature = payload[index + 3] | (payload[index + 4] << 8);
-
-	unsigned short setTemperature;
-	setTemperature = payload[index + 5] | (payload[index + 6] << 8);
-
-	if (engineInstance > 0) {
-		dualEngine = TRUE;
-	}
-
-	// Source 14 indicates exhaust temperature
-	if ((source == 14) && (IsDataValid(actualTemperature))) {
-
-		switch (engineInstance) {
-			case 0:
-				if (dualEngine) {
-					if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, CONVERT_KELVIN((actualTemperature * 0.01f)), _T("\u00B0 C"));
-					}
-					if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN((actualTemperature * 0.01f))), _T("\u00B0 F"));
-					}
-				}
-				else {
-					if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, CONVERT_KELVIN((actualTemperature * 0.01f)), _T("\u00B0 C"));
-					}
-					if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN((actualTemperature * 0.01f))), _T("\u00B0 F"));
-					}
-				}
-				break;
-			case 1:
-				if (g_iDashTemperatureUnit == TEMPERATURE_CELSIUS) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, CONVERT_KELVIN((actualTemperature * 0.01f)), _T("\u00B0 C"));
-				}
-				if (g_iDashTemperatureUnit == TEMPERATURE_FAHRENHEIT) {
-					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN((actualTemperature * 0.01f))), _T("\u00B0 F"));
-				}
-				break;
-		}
-	}
+	Enqueue(INGEST_N2K_130312, GetN2000Payload(id_130312, ev));
 }
 
 // PGN 127245 Rudder Angle 
 void dashboard_pi::HandleN2K_127245(ObservedEvt ev) {
 	NMEA2000Id id_127245(127245);
-	std::vector<uint8_t>payload = GetN2000Payload(id_127245, ev);
-
-	byte instance;
-	instance = payload[index + 0];
-
-	byte directionOrder;
-	directionOrder = payload[index + 1] & 0x03;
-
-	short angleOrder; // 0.0001 radians
-	angleOrder = payload[index + 2] | (payload[index + 3] << 8);
-
-	short position; // 0.0001 radians
-	position = payload[index + 4] | (payload[index + 5] << 8);
-
-	if (IsDataValid(position)) {
-		// Ignore rudder instance assume that it refers to the main rudder
-		SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, RADIANS_TO_DEGREES((float)position * 1e-4), _T("\u00B0"));
-	}
+	Enqueue(INGEST_N2K_127245, GetN2000Payload(id_127245, ev));
 }
 
 
@@ -2252,10 +1064,13 @@ void dashboard_pi::ShowPreferencesDialog(wxWindow* parent) {
 		g_pFontData = new wxFont(dialog->m_pFontPickerData->GetSelectedFont());
 		g_pFontLabel = new wxFont(dialog->m_pFontPickerLabel->GetSelectedFont());
 		g_pFontSmall = new wxFont(dialog->m_pFontPickerSmall->GetSelectedFont());
+		InvalidateTextExtentCache();
+		InvalidateGlyphAtlases();
 
 		// OnClose should handle that for us normally but it doesn't seems to do so
 		// We must save changes first
 		dialog->SaveDashboardConfig();
+		PublishDecoderSettings();
 		m_ArrayOfDashboardWindow.Clear();
 		m_ArrayOfDashboardWindow = dialog->m_Config;
 		// Reload the saved dashboard instruments
@@ -2272,6 +1087,8 @@ void dashboard_pi::ShowPreferencesDialog(wxWindow* parent) {
 
 
 void dashboard_pi::SetColorScheme(PI_ColorScheme cs) {
+    g_ColorScheme = cs;
+    UpdatePalette();
     for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
         DashboardWindow *dashboard_window = m_ArrayOfDashboardWindow.Item(i)->m_pDashboardWindow;
 		if (dashboard_window) {
@@ -2457,12 +1274,19 @@ bool dashboard_pi::LoadConfig(void) {
 			g_pFontSmall->SetNativeFontInfo(config);
 		}
 
+		// Any text measured or rasterized with the default fonts is now stale
+		InvalidateTextExtentCache();
+		InvalidateGlyphAtlases();
+
 		// Load the maximum tachometer value, Temperature & Pressure units and dual engine status
 		pConf->Read(_T("TachometerMax"), &g_iDashTachometerMax, 6000);
 		pConf->Read(_T("TemperatureUnit"), &g_iDashTemperatureUnit, TEMPERATURE_CELSIUS);
 		pConf->Read(_T("PressureUnit"), &g_iDashPressureUnit, PRESSURE_BAR);
         pConf->Read(_T("DualEngine"), &dualEngine, false);
         pConf->Read(_T("TwentyFourVolt"), &twentyFourVolts, false);
+		pConf->Read(_T("Diagnostics"), &m_diagnostics, false);
+		pConf->Read(_T("CompositeRendering"), &g_bCompositeRendering, false);
+		pConf->Read(_T("FrameBudget"), &m_frameBudget, DEFAULT_FRAME_BUDGET);
 		
 		// Now retrieve the number of dashboard containers and their instruments
         int d_cnt;
@@ -2631,6 +1455,8 @@ void dashboard_pi::ApplyConfig(void) {
             pane.Caption(cont->m_sCaption).Show(cont->m_bIsVisible);
             if (!cont->m_pDashboardWindow->isInstrumentListEqual(cont->m_aInstrumentList)) {
                 cont->m_pDashboardWindow->SetInstrumentList(cont->m_aInstrumentList);
+                // The new instruments are brought up to date with the latest values
+                cont->m_bSuspended = true;
                 wxSize sz = cont->m_pDashboardWindow->GetMinSize();
                 pane.MinSize(sz).BestSize(sz).FloatingSize(sz);
             }
@@ -3131,10 +1957,18 @@ unsigned int AddInstrumentDlg::GetInstrumentAdded() {
 // wxWS_EX_VALIDATE_RECURSIVELY required to push events to parents
 DashboardWindow::DashboardWindow(wxWindow *pparent, wxWindowID id, wxAuiManager *auimgr,
         dashboard_pi* plugin, int orient, DashboardWindowContainer* mycont) :
-        wxWindow(pparent, id, wxDefaultPosition, wxDefaultSize, wxBORDER_DEFAULT) {
+        wxWindow(pparent, id, wxDefaultPosition, wxDefaultSize, wxBORDER_DEFAULT), m_animationTimer(this) {
     m_pauimgr = auimgr;
     m_plugin = plugin;
     m_Container = mycont;
+    m_composite = g_bCompositeRendering;
+    m_frameCost = 0;
+
+    if (m_composite) {
+        SetBackgroundStyle(wxBG_STYLE_CUSTOM);
+        Connect(wxEVT_ERASE_BACKGROUND, wxEraseEventHandler(DashboardWindow::OnEraseBackground), NULL, this);
+        Connect(wxEVT_PAINT, wxPaintEventHandler(DashboardWindow::OnPaint), NULL, this);
+    }
 
 	// wx2.9 itemBoxSizer = new wxWrapSizer(orient);
     itemBoxSizer = new wxBoxSizer(orient);
@@ -3144,9 +1978,12 @@ DashboardWindow::DashboardWindow(wxWindow *pparent, wxWindowID id, wxAuiManager
             this);
     Connect(wxEVT_COMMAND_MENU_SELECTED,
             wxCommandEventHandler(DashboardWindow::OnContextMenuSelect), NULL, this);
+    Connect(m_animationTimer.GetId(), wxEVT_TIMER, wxTimerEventHandler(DashboardWindow::OnAnimationTimer), NULL, this);
 }
 
 DashboardWindow::~DashboardWindow() {
+    m_animationTimer.Stop();
+    ReleaseBackBuffer(m_backBuffer);
     for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
         DashboardInstrumentContainer *pdic = m_ArrayOfInstrument.Item(i);
         delete pdic;
@@ -3157,12 +1994,84 @@ void DashboardWindow::OnSize(wxSizeEvent& event) {
     event.Skip();
     for (unsigned int i=0; i<m_ArrayOfInstrument.size(); i++) {
         DashboardInstrument* inst = m_ArrayOfInstrument.Item(i)->m_pInstrument;
-        inst->SetMinSize(inst->GetSize(itemBoxSizer->GetOrientation(), GetClientSize()));
+        wxSize size = inst->GetSize(itemBoxSizer->GetOrientation(), GetClientSize());
+        if (m_ArrayOfInstrument.Item(i)->m_cell) {
+            m_ArrayOfInstrument.Item(i)->m_cell->SetMinSize(size);
+        }
+        else {
+            inst->SetMinSize(size);
+        }
     }
     Layout();
+    LayoutCells();
     Refresh();
 }
 
+// Composited instruments are hidden windows, sized to match the space reserved for them
+void DashboardWindow::LayoutCells(void) {
+    for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
+        DashboardInstrumentContainer *container = m_ArrayOfInstrument.Item(i);
+        if (container->m_cell) {
+            container->m_pInstrument->SetSize(container->m_cell->GetRect());
+        }
+    }
+}
+
+void DashboardWindow::OnEraseBackground(wxEraseEvent& WXUNUSED(evt)) {
+    // intentionally empty
+}
+
+// Paint every damaged instrument into the back-buffer in a single pass, then copy the damaged area to the window
+void DashboardWindow::OnPaint(wxPaintEvent& WXUNUSED(evt)) {
+    wxPaintDC pdc(this);
+    wxSize size = GetClientSize();
+    if (size.x == 0 || size.y == 0) {
+        return;
+    }
+
+    wxStopWatch frameTimer;
+    wxRect update = GetUpdateRegion().GetBox();
+    if (update.IsEmpty()) {
+        update = wxRect(size);
+    }
+
+    double scale = GetContentScale(this);
+    if (!IsScaledBitmapValid(m_backBuffer, size, scale)) {
+        ResizeBackBuffer(m_backBuffer, size, scale);
+        update = wxRect(size);
+    }
+
+    wxMemoryDC mdc(m_backBuffer);
+    {
+        wxGCDC dc(mdc);
+        dc.SetClippingRegion(update);
+        dc.SetBackground(GetBackgroundColour());
+        dc.Clear();
+        dc.DestroyClippingRegion();
+
+        for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
+            DashboardInstrument *instrument = m_ArrayOfInstrument.Item(i)->m_pInstrument;
+            wxRect cell = instrument->GetRect();
+            wxRect damage = cell.Intersect(update);
+            if (damage.IsEmpty()) {
+                continue;
+            }
+            damage.Offset(-cell.x, -cell.y);
+            dc.SetDeviceOrigin(cell.x, cell.y);
+            mdc.SetDeviceOrigin(cell.x, cell.y);
+            instrument->Paint(dc, mdc, damage);
+        }
+        dc.SetDeviceOrigin(0, 0);
+        mdc.SetDeviceOrigin(0, 0);
+    }
+
+    pdc.Blit(update.x, update.y, update.width, update.height, &mdc, update.x, update.y);
+    mdc.SelectObject(wxNullBitmap);
+    double elapsed = frameTimer.TimeInMicro().ToDouble() / 1000.0;
+    m_frameCost = (0.8 * m_frameCost) + (0.2 * elapsed);
+    AddPaintTime(elapsed);
+}
+
 void DashboardWindow::OnContextMenu(wxContextMenuEvent& event) {
     wxMenu* contextMenu = new wxMenu();
 
@@ -3220,7 +2129,7 @@ void DashboardWindow::SetColorScheme(PI_ColorScheme cs) {
     
     // Improve appearance, especially in DUSK or NIGHT palette
     wxColour col;
-    GetGlobalColor(_T("DASHL"), &col);
+    col = g_Palette.title;
     SetBackgroundColour(col);
     Refresh(false);
 }
@@ -3248,9 +2157,16 @@ void DashboardWindow::SetSizerOrientation(int orient) {
         node->GetData()->SetMinSize(wxDefaultSize);
         node = node->GetNext();
     }
+    for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
+        DashboardInstrumentContainer *container = m_ArrayOfInstrument.Item(i);
+        if (container->m_cell) {
+            container->m_cell->SetMinSize(container->m_pInstrument->GetSize(orient, wxDefaultSize));
+        }
+    }
     SetMinSize(wxDefaultSize);
     Fit();
     SetMinSize(itemBoxSizer->GetMinSize());
+    LayoutCells();
 }
 
 int DashboardWindow::GetSizerOrientation() {
@@ -3272,6 +2188,12 @@ bool DashboardWindow::isInstrumentListEqual(const wxArrayInt& list) {
 
 // Create and display each instrument in a dashboard container
 void DashboardWindow::SetInstrumentList(wxArrayInt list) {
+    // Composited instruments are not held by the sizer, so are not destroyed with it
+    for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
+        if (m_ArrayOfInstrument.Item(i)->m_cell) {
+            m_ArrayOfInstrument.Item(i)->m_pInstrument->Destroy();
+        }
+    }
     m_ArrayOfInstrument.Clear();
     itemBoxSizer->Clear(true);
     for (size_t i = 0; i < list.GetCount(); i++) {
@@ -3285,6 +2207,7 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list) {
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(200, DIAL_MARKER_SIMPLE, 1);
 				((DashboardInstrument_Dial *)instrument)->SetOptionExtraValue(OCPN_DBP_STC_MAIN_ENGINE_HOURS, _T("%.1f"), DIAL_POSITION_INSIDE);
 				((DashboardInstrument_Dial*)instrument)->SetOptionWarningValue(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(0.25);
 				break;
 			case ID_DBP_PORT_ENGINE_RPM:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
@@ -3293,6 +2216,7 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list) {
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(200, DIAL_MARKER_SIMPLE, 1);
 				((DashboardInstrument_Dial *)instrument)->SetOptionExtraValue(OCPN_DBP_STC_PORT_ENGINE_HOURS, _T("%.1f"), DIAL_POSITION_INSIDE);
 				((DashboardInstrument_Dial*)instrument)->SetOptionWarningValue(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(0.25);
 				break;
 			case ID_DBP_STBD_ENGINE_RPM:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
@@ -3301,6 +2225,7 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list) {
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(200, DIAL_MARKER_SIMPLE, 1);
 				((DashboardInstrument_Dial *)instrument)->SetOptionExtraValue(OCPN_DBP_STC_STBD_ENGINE_HOURS, _T("%.1f"), DIAL_POSITION_INSIDE);
 				((DashboardInstrument_Dial*)instrument)->SetOptionWarningValue(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(0.25);
 				break;
 			case ID_DBP_MAIN_ENGINE_OIL:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
@@ -3391,54 +2316,63 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list) {
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_FUEL_01, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5,	DIAL_MARKER_WARNING_LOW, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_WATER_TANK_01:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_WATER_01, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5,	DIAL_MARKER_WARNING_LOW, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_FUEL_TANK_02:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_FUEL_02, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5, DIAL_MARKER_WARNING_LOW, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_WATER_TANK_02:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_WATER_02, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5, DIAL_MARKER_WARNING_LOW, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_WATER_TANK_03:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_WATER_03, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5, DIAL_MARKER_WARNING_LOW, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_OIL_TANK:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_OIL, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5, DIAL_MARKER_WARNING_LOW, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_LIVEWELL_TANK:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5, DIAL_MARKER_WARNING_LOW, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_GREY_TANK:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_GREY, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5, DIAL_MARKER_WARNING_HIGH, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_BLACK_TANK:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY,
 					GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_BLACK, 0, 100);
 				((DashboardInstrument_Dial *)instrument)->SetOptionLabel(25, DIAL_LABEL_FRACTIONS);
 				((DashboardInstrument_Dial *)instrument)->SetOptionMarker(12.5, DIAL_MARKER_WARNING_HIGH, 1);
+				((DashboardInstrument_Dial *)instrument)->SetOptionNeedleDamping(1.5);
 				break;
 			case ID_DBP_START_BATTERY_VOLTS:
 				instrument = new DashboardInstrument_Speedometer(this, wxID_ANY, GetInstrumentCaption(id), 
@@ -3459,6 +2393,7 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list) {
 				((DashboardInstrument_RudderAngle *)instrument)->SetOptionMarker(5, DIAL_MARKER_REDGREEN, 2);
 				wxString labels[] = {_T("40"), _T("30"), _T("20"), _T("10"), _T("0"), _T("10"), _T("20"), _T("30"), _T("40")};
 				((DashboardInstrument_RudderAngle *)instrument)->SetOptionLabel(10, DIAL_LABEL_HORIZONTAL, wxArrayString(9,labels));
+				((DashboardInstrument_RudderAngle *)instrument)->SetOptionNeedleDamping(0.2);
 				break;
 			}
 			case ID_DBP_FUEL_TANK_GAUGE_01:
@@ -3476,11 +2411,41 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list) {
 			case ID_DBP_WATER_TANK_GAUGE_03:
 				instrument = new DashboardInstrument_Block(this, wxID_ANY, GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, "%s");
 				break;
+			case ID_DBP_FUEL_TANK_BAR_01:
+				instrument = new DashboardInstrument_Gauge(this, wxID_ANY, GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01);
+				((DashboardInstrument_Gauge *)instrument)->SetOptionThresholds(20, 100);
+				break;
+			case ID_DBP_FUEL_TANK_BAR_02:
+				instrument = new DashboardInstrument_Gauge(this, wxID_ANY, GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02);
+				((DashboardInstrument_Gauge *)instrument)->SetOptionThresholds(20, 100);
+				break;
+			case ID_DBP_WATER_TANK_BAR_01:
+				instrument = new DashboardInstrument_Gauge(this, wxID_ANY, GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01);
+				((DashboardInstrument_Gauge *)instrument)->SetOptionThresholds(20, 100);
+				break;
+			case ID_DBP_WATER_TANK_BAR_02:
+				instrument = new DashboardInstrument_Gauge(this, wxID_ANY, GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02);
+				((DashboardInstrument_Gauge *)instrument)->SetOptionThresholds(20, 100);
+				break;
+			case ID_DBP_WATER_TANK_BAR_03:
+				instrument = new DashboardInstrument_Gauge(this, wxID_ANY, GetInstrumentCaption(id), OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03);
+				((DashboardInstrument_Gauge *)instrument)->SetOptionThresholds(20, 100);
+				break;
 		}
         if (instrument) {
             instrument->instrumentTypeId = id;
-            m_ArrayOfInstrument.Add(new DashboardInstrumentContainer(id, instrument,instrument->GetCapacity()));
-            itemBoxSizer->Add(instrument, 0, wxEXPAND, 0);
+            DashboardInstrumentContainer *container = new DashboardInstrumentContainer(id, instrument, instrument->GetCapacity());
+            m_ArrayOfInstrument.Add(container);
+            if (m_composite) {
+                // The instrument's window is never shown, a spacer reserves its space
+                instrument->Hide();
+                instrument->SetComposited(true);
+                wxSize size = instrument->GetSize(itemBoxSizer->GetOrientation(), wxDefaultSize);
+                container->m_cell = itemBoxSizer->Add(size.x, size.y, 0, wxEXPAND, 0);
+            }
+            else {
+                itemBoxSizer->Add(instrument, 0, wxEXPAND, 0);
+            }
             if (itemBoxSizer->GetOrientation() == wxHORIZONTAL) {
                 itemBoxSizer->AddSpacer(5);
             }
@@ -3488,6 +2453,7 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list) {
     }
     Fit();
     Layout();
+    LayoutCells();
     SetMinSize(itemBoxSizer->GetMinSize());
 }
 
@@ -3495,6 +2461,42 @@ void DashboardWindow::SendSentenceToAllInstruments(DASH_CAP st, double value, wx
     for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
 		if (m_ArrayOfInstrument.Item(i)->m_cap_flag.test(st)) {
 			m_ArrayOfInstrument.Item(i)->m_pInstrument->SetData(st, value, unit);
+			m_ArrayOfInstrument.Item(i)->m_pInstrument->NotifyDataUpdate(st, value);
+			if (!m_animationTimer.IsRunning() && m_ArrayOfInstrument.Item(i)->m_pInstrument->IsAnimating()) {
+				m_animationTimer.Start(GetAnimationInterval(), wxTIMER_CONTINUOUS);
+			}
 		}
     }
 }
+
+// Each instrument is visited once, receiving whichever of the values it displays
+void DashboardWindow::SendBatchToAllInstruments(const DecodedValue *values, size_t count) {
+	for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
+		DashboardInstrumentContainer *container = m_ArrayOfInstrument.Item(i);
+		bool updated = SendValuesToInstrument(container->m_pInstrument, container->m_cap_flag, values, count);
+		if (updated && !m_animationTimer.IsRunning() && container->m_pInstrument->IsAnimating()) {
+			m_animationTimer.Start(GetAnimationInterval(), wxTIMER_CONTINUOUS);
+		}
+	}
+}
+
+// Applies a change of the animation interval, see GetAnimationInterval
+void DashboardWindow::RestartAnimationTimer(void) {
+	if (m_animationTimer.IsRunning() && (m_animationTimer.GetInterval() != GetAnimationInterval())) {
+		m_animationTimer.Start(GetAnimationInterval(), wxTIMER_CONTINUOUS);
+	}
+}
+
+// Step each moving needle, stopping the timer once they have all settled
+void DashboardWindow::OnAnimationTimer(wxTimerEvent& evt) {
+	wxLongLong now = wxGetLocalTimeMillis();
+	bool moving = false;
+	for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
+		if (m_ArrayOfInstrument.Item(i)->m_pInstrument->Animate(now)) {
+			moving = true;
+		}
+	}
+	if (!moving) {
+		m_animationTimer.Stop();
+	}
+}
@@ -0,0 +1,1709 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Decodes NMEA 0183, NMEA 2000 & SignalK data, refer to decoder.h
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "decoder.h"
+
+#include <cmath>
+
+DashboardDecoder::DashboardDecoder(DecoderListener *listener) {
+	m_listener = listener;
+	m_publishedTemperatureUnit = TEMPERATURE_CELSIUS;
+	m_publishedPressureUnit = PRESSURE_BAR;
+	m_publishedDualEngine = false;
+	m_decodeSettings.temperatureUnit = TEMPERATURE_CELSIUS;
+	m_decodeSettings.pressureUnit = PRESSURE_BAR;
+	m_decodeSettings.dualEngine = false;
+	engineWatchDog = 0;
+	tankLevelWatchDog = 0;
+	mainEngineHours = 0;
+	portEngineHours = 0;
+	stbdEngineHours = 0;
+}
+
+// Invoked on the UI thread whenever the preferences used by the decoders are loaded or changed
+void DashboardDecoder::PublishSettings(const DecoderSettings &settings) {
+	m_publishedTemperatureUnit = settings.temperatureUnit;
+	m_publishedPressureUnit = settings.pressureUnit;
+	m_publishedDualEngine = settings.dualEngine;
+}
+
+// The preferences are copied first, so that they are consistent for the whole payload
+void DashboardDecoder::DecodeItem(IngestItem &item) {
+	m_decodeSettings.temperatureUnit = m_publishedTemperatureUnit;
+	m_decodeSettings.pressureUnit = m_publishedPressureUnit;
+	m_decodeSettings.dualEngine = m_publishedDualEngine;
+	switch (item.type) {
+		case INGEST_NMEA0183_XDR:
+			DecodeXDR(item.sentence);
+			break;
+		case INGEST_NMEA0183_RPM:
+			DecodeRPM(item.sentence);
+			break;
+		case INGEST_NMEA0183_RSA:
+			DecodeRSA(item.sentence);
+			break;
+		case INGEST_N2K_127488:
+			DecodeN2K_127488(item.payload);
+			break;
+		case INGEST_N2K_127489:
+			DecodeN2K_127489(item.payload);
+			break;
+		case INGEST_N2K_127505:
+			DecodeN2K_127505(item.payload);
+			break;
+		case INGEST_N2K_127508:
+			DecodeN2K_127508(item.payload);
+			break;
+		case INGEST_N2K_130312:
+			DecodeN2K_130312(item.payload);
+			break;
+		case INGEST_N2K_127245:
+			DecodeN2K_127245(item.payload);
+			break;
+		case INGEST_SIGNALK:
+			ParseSignalK(item.sentence);
+			break;
+	}
+}
+
+// A second engine instance makes this a dual engine vessel. The decoder uses this for the rest
+// of the payload, and the listener updates the preference, which is then published back to the decoder.
+void DashboardDecoder::DetectDualEngine(int engineInstance) {
+	if ((engineInstance > 0) && (!m_decodeSettings.dualEngine)) {
+		m_decodeSettings.dualEngine = true;
+		m_listener->OnDualEngineDetected();
+	}
+}
+
+// a few conversion functions
+double DashboardDecoder::Celsius2Fahrenheit(double temperature) {
+	return (temperature * 9 / 5) + 32;
+}
+
+double DashboardDecoder::Fahrenheit2Celsius(double temperature) {
+	return (temperature - 32) * 5 / 9;
+}
+
+double DashboardDecoder::Pascal2Psi(double pressure) {
+	return pressure * 0.000145f;
+}
+
+double DashboardDecoder::Psi2Pascal(double pressure) {
+	return pressure * 6894.745f;
+}
+
+// One of those FFS moments
+// Have to know the type of the value before retrieving.
+double DashboardDecoder::GetJsonDouble(wxJSONValue &value) {
+	double d_ret;
+	if (value.IsDouble()) {
+		return d_ret = value.AsDouble();
+	}
+	else if (value.IsInt()) {
+		int i_ret = value.AsInt();
+		return d_ret = i_ret;
+	}
+	else {
+		return nan("");
+	}
+}
+
+// Parse SignalK derived data, invoked on the decode thread
+void DashboardDecoder::ParseSignalK(const wxString &message_body) {
+	if (jsonReader.Parse(message_body, &root) > 0) {
+		wxLogMessage("Engine Dashboard, JSON Error in following");
+		wxLogMessage("%s", message_body);
+		wxArrayString jsonErrors = jsonReader.GetErrors();
+		for (auto it : jsonErrors) {
+			wxLogMessage(it);
+		}
+		return;
+	}
+
+	if (root.HasMember("self")) {
+		if (root["self"].AsString().StartsWith(_T("vessels.")))
+			self = (root["self"].AsString());  // for java server, and OpenPlotter node.js server 1.20
+		else
+			self = _T("vessels.") + (root["self"].AsString()); // for Node.js server
+	}
+
+	if (root.HasMember("context") && root["context"].IsString()) {
+		auto context = root["context"].AsString();
+		if (context != self) {
+			return;
+		}
+	}
+
+	if (root.HasMember("updates") && root["updates"].IsArray()) {
+		wxJSONValue &updates = root["updates"];
+		for (int i = 0; i < updates.Size(); ++i) {
+			HandleSKUpdate(updates[i]);
+		}
+	}
+}
+
+void DashboardDecoder::HandleSKUpdate(wxJSONValue &update) {
+	if (update.HasMember("values")	&& update["values"].IsArray()) {
+		for (int j = 0; j < update["values"].Size(); ++j) {
+			wxJSONValue &item = update["values"][j];
+			UpdateSKItem(item);
+		}
+	}
+}
+
+void DashboardDecoder::UpdateSKItem(wxJSONValue &item) {
+	if (item.HasMember("path") && item.HasMember("value")) {
+		const wxString &update_path = item["path"].AsString();
+		wxJSONValue &value = item["value"];
+
+		if (update_path.StartsWith("propulsion")) {
+			engineWatchDog = wxGetLocalTime();
+		}
+
+		// Units in revolutions per second
+		if ((update_path == _T("propulsion.port.revolutions")) && (!m_decodeSettings.dualEngine)) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, GetJsonDouble(value) * 60, "RPM");
+		}
+
+		if ((update_path == _T("propulsion.port.revolutions")) && (m_decodeSettings.dualEngine)) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, GetJsonDouble(value) * 60, "RPM");
+		}
+
+		if (update_path == _T("propulsion.starboard.revolutions")) {
+			// dualEngine = TRUE;
+			SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, GetJsonDouble(value) * 60, "RPM");
+		}
+		
+		// Units in volts
+		if ((update_path == _T("propulsion.port.alternatorVoltage")) && (!m_decodeSettings.dualEngine)) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, GetJsonDouble(value), "Volts");
+		}
+
+		if ((update_path == _T("propulsion.port.alternatorVoltage")) && (m_decodeSettings.dualEngine)) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, GetJsonDouble(value), "Volts");
+		}
+
+		if (update_path == _T("propulsion.starboard.alternatorVoltage")) {
+			// dualEngine = TRUE;
+			SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, GetJsonDouble(value), "Volts");
+		}
+
+		if (m_decodeSettings.pressureUnit == PRESSURE_BAR) {
+			// Units are in Pascals. 100000 Pascals = 1 Bar
+			if ((update_path == _T("propulsion.port.oilPressure")) && (!m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, GetJsonDouble(value) * 1e-5, "Bar");
+			}
+
+			if ((update_path == _T("propulsion.port.oilPressure")) && (m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, GetJsonDouble(value) * 1e-5, "Bar");
+			}
+
+			if (update_path == _T("propulsion.starboard.oilPressure")) {
+				// dualEngine = TRUE;
+				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, GetJsonDouble(value) * 1e-5, "Bar");
+			}
+		}
+
+		else if (m_decodeSettings.pressureUnit == PRESSURE_PSI) {
+			if ((update_path == _T("propulsion.port.oilPressure")) && (!m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(GetJsonDouble(value)), "Psi");
+			}
+
+			if ((update_path == _T("propulsion.port.oilPressure")) && (m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(GetJsonDouble(value)), "Psi");
+			}
+
+			if (update_path == _T("propulsion.starboard.oilPressure")) {
+				// dualEngine = TRUE;
+				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(GetJsonDouble(value)), "Psi");
+			}
+		}
+		
+		if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+			// Units are in Kelvin
+			if ((update_path == _T("propulsion.port.temperature")) && (!m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
+			}
+
+			if ((update_path == _T("propulsion.port.temperature")) && (m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
+			}
+
+			if (update_path == _T("propulsion.starboard.temperature")) {
+				// dualEngine = TRUE;
+				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
+			}
+
+			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (!m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
+			}
+
+			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
+			}
+
+			if (update_path == _T("propulsion.starboard.exhaustTemperature")) {
+				// dualEngine = TRUE;
+				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, CONVERT_KELVIN(GetJsonDouble(value)), _T("\u00B0 C"));
+			}
+		}
+		else if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+			if ((update_path == _T("propulsion.port.temperature")) && (!m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
+			}
+
+			if ((update_path == _T("propulsion.port.temperature")) && (m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
+			}
+
+			if (update_path == _T("propulsion.starboard.temperature")) {
+				// dualEngine = TRUE;
+				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
+			}
+
+			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (!m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
+			}
+
+			if ((update_path == _T("propulsion.port.exhaustTemperature")) && (m_decodeSettings.dualEngine)) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
+			}
+
+			if (update_path == _T("propulsion.starboard.exhaustTemperature")) {
+				// dualEngine = TRUE;
+				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN(GetJsonDouble(value))), _T("\u00B0 F"));
+			}
+		}
+		// Units are in seconds
+		if ((update_path == _T("propulsion.port.runTime")) && (!m_decodeSettings.dualEngine)) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, value.AsInt() / 3600.0, "Hrs");
+		}
+
+		if ((update_path == _T("propulsion.port.runTime")) && (m_decodeSettings.dualEngine)) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, value.AsInt() / 3600.0, "Hrs");
+		}
+
+		if (update_path == _T("propulsion.starboard.runTime")) {
+			// dualEngine = TRUE;
+			SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, value.AsInt() / 3600.0, "Hrs");
+		}
+
+		if (update_path == _T("electrical.batteries.0.voltage")) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, GetJsonDouble(value), "Volts");
+		}
+
+		if (update_path == _T("electrical.batteries.0.current")) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, GetJsonDouble(value), "Amps");
+		}
+
+		if (update_path == _T("electrical.batteries.1.voltage")) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, GetJsonDouble(value), "Volts");
+		}
+
+		if (update_path == _T("electrical.batteries.1.current")) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, GetJsonDouble(value), "Amps");
+		}
+
+		if (update_path.StartsWith(_T("steering.rudderAngle"))) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, RADIANS_TO_DEGREES(GetJsonDouble(value)), _T("\u00B0"));
+		}
+
+		// Engine Warning state = "alarm" or "normal"
+		if (update_path.StartsWith("notifications.propulsion", NULL)) {
+			// Status One Alarm conditions
+			// Main Engine
+			// Bit 0
+			if ((update_path == "notifications.propulsion.port.checkEngine") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 1, wxEmptyString);
+				}
+			}
+			// Bit 1
+			if ((update_path == "notifications.propulsion.port.overTemperature") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 2, wxEmptyString);
+				}
+			}
+			// Bit 2
+			if ((update_path == "notifications.propulsion.port.lowOilPressure") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 4, wxEmptyString);
+				}
+			}
+			// Bit 3
+			if ((update_path == "notifications.propulsion.port.lowOilLevel") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 8, wxEmptyString);
+				}
+			}
+			// Bit 4
+			if ((update_path == "notifications.propulsion.port.lowFuelPressure") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 16, wxEmptyString);
+				}
+			}
+			// Bit 5
+			if ((update_path == "notifications.propulsion.port.lowSystemVoltage") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 32, wxEmptyString);
+				}
+			}
+			// Bit 6
+			if ((update_path == "notifications.propulsion.port.lowCoolantLevel") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 64, wxEmptyString);
+				}
+			}
+			// Bit 7
+			if ((update_path == "notifications.propulsion.port.waterFlow") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 128, wxEmptyString);
+				}
+			}
+			// Bit 8
+			if ((update_path == "notifications.propulsion.port.waterInFuel") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 256, wxEmptyString);
+				}
+			}
+			// Bit 9
+			if ((update_path == "notifications.propulsion.port.chargeIndicator") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 512, wxEmptyString);
+				}
+			}
+			// Bit 10
+			if ((update_path == "notifications.propulsion.port.preheatIndicator") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 1024, wxEmptyString);
+				}
+			}
+			// Bit 11
+			if ((update_path == "notifications.propulsion.port.highBoostPressure") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 2048, wxEmptyString);
+				}
+			}
+			// Bit 12
+			if ((update_path == "notifications.propulsion.port.revLimitExceeded") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 4096, wxEmptyString);
+				}
+			}
+			// Bit 13
+			if ((update_path == "notifications.propulsion.port.eGRSystem") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 8192, wxEmptyString);
+				}
+			}
+			// Bit 14
+			if ((update_path == "notifications.propulsion.port.throttlePositionSensor") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 16384, wxEmptyString);
+				}
+			}
+			//Bit 15
+			if ((update_path == "notifications.propulsion.port.emergencyStopMode") && (!m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 32768, wxEmptyString);
+				}
+			}
+			// Port Engine
+			// Bit 0
+			if ((update_path == "notifications.propulsion.port.checkEngine") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 1, wxEmptyString);
+				}
+			}
+			// Bit 1
+			if ((update_path == "notifications.propulsion.port.overTemperature") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 2, wxEmptyString);
+				}
+			}
+			// Bit 2
+			if ((update_path == "notifications.propulsion.port.lowOilPressure") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 4, wxEmptyString);
+				}
+			}
+			// Bit 3
+			if ((update_path == "notifications.propulsion.port.lowOilLevel") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 8, wxEmptyString);
+				}
+			}
+			// Bit 4
+			if ((update_path == "notifications.propulsion.port.lowFuelPressure") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 16, wxEmptyString);
+				}
+			}
+			// Bit 5
+			if ((update_path == "notifications.propulsion.port.lowSystemVoltage") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 32, wxEmptyString);
+				}
+			}
+			// Bit 6
+			if ((update_path == "notifications.propulsion.port.lowCoolantLevel") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 64, wxEmptyString);
+				}
+			}
+			// Bit 7
+			if ((update_path == "notifications.propulsion.port.waterFlow") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 128, wxEmptyString);
+				}
+			}
+			// Bit 8
+			if ((update_path == "notifications.propulsion.port.waterInFuel") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 256, wxEmptyString);
+				}
+			}
+			// Bit 9
+			if ((update_path == "notifications.propulsion.port.chargeIndicator") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 512, wxEmptyString);
+				}
+			}
+			// Bit 10
+			if ((update_path == "notifications.propulsion.port.preheatIndicator") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 1024, wxEmptyString);
+				}
+			}
+			// Bit 11
+			if ((update_path == "notifications.propulsion.port.highBoostPressure") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 2048, wxEmptyString);
+				}
+			}
+			// Bit 12
+			if ((update_path == "notifications.propulsion.port.revLimitExceeded") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 4096, wxEmptyString);
+				}
+			}
+			// Bit 13
+			if ((update_path == "notifications.propulsion.port.eGRSystem") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 8192, wxEmptyString);
+				}
+			}
+			// Bit 14
+			if ((update_path == "notifications.propulsion.port.throttlePositionSensor") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 16384, wxEmptyString);
+				}
+			}
+			//Bit 15
+			if ((update_path == "notifications.propulsion.port.emergencyStopMode") && (m_decodeSettings.dualEngine)) {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, 32768, wxEmptyString);
+				}
+			}
+
+			// Starboard Engine
+			// Bit 0
+			if (update_path == "notifications.propulsion.starboard.checkEngine") {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 1, wxEmptyString);
+				}
+			}
+			// Bit 1
+			if (update_path == "notifications.propulsion.starboard.overTemperature")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 2, wxEmptyString);
+				}
+			}
+			// Bit 2
+			if (update_path == "notifications.propulsion.starboard.lowOilPressure")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 4, wxEmptyString);
+				}
+			}
+			// Bit 3
+			if (update_path == "notifications.propulsion.starboard.lowOilLevel")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 8, wxEmptyString);
+				}
+			}
+			// Bit 4
+			if (update_path == "notifications.propulsion.starboard.lowFuelPressure")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 16, wxEmptyString);
+				}
+			}
+			// Bit 5
+			if (update_path == "notifications.propulsion.starboard.lowSystemVoltage")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 32, wxEmptyString);
+				}
+			}
+			// Bit 6
+			if (update_path == "notifications.propulsion.starboard.lowCoolantLevel")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 64, wxEmptyString);
+				}
+			}
+			// Bit 7
+			if (update_path == "notifications.propulsion.starboard.waterFlow")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 128, wxEmptyString);
+				}
+			}
+			// Bit 8
+			if (update_path == "notifications.propulsion.starboard.waterInFuel")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 256, wxEmptyString);
+				}
+			}
+			// Bit 9
+			if (update_path == "notifications.propulsion.starboard.chargeIndicator")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 512, wxEmptyString);
+				}
+			}
+			// Bit 10
+			if (update_path == "notifications.propulsion.starboard.preheatIndicator")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 1024, wxEmptyString);
+				}
+			}
+			// Bit 11
+			if (update_path == "notifications.propulsion.starboard.highBoostPressure")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 2048, wxEmptyString);
+				}
+			}
+			// Bit 12
+			if (update_path == "notifications.propulsion.starboard.revLimitExceeded")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 4096, wxEmptyString);
+				}
+			}
+			// Bit 13
+			if (update_path == "notifications.propulsion.starboard.eGRSystem")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 8192, wxEmptyString);
+				}
+			}
+			// Bit 14
+			if (update_path == "notifications.propulsion.starboard.throttlePositionSensor")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 16384, wxEmptyString);
+				}
+			}
+			//Bit 15
+			if (update_path == "notifications.propulsion.starboard.emergencyStopMode")  {
+				if (CheckAlarmState(value)) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, 32768, wxEmptyString);
+				}
+			}
+			/////////////////
+
+			// Status Two Error Codes
+			// Currently Don't have icons for these, nor do I handle these in native NMEA 2000
+			// Bit 0
+			if (update_path == "notifications.propulsion.port.warningLevel1") {
+
+			} 
+			// Bit 1
+			if (update_path == "notifications.propulsion.port.warningLevel2") {
+
+			} 
+			// Bit 2
+			if (update_path == "notifications.propulsion.port.powerReduction") {
+
+			} 
+			// Bit 3
+			if (update_path == "notifications.propulsion.port.maintenanceNeeded") {
+
+			} 
+			// Bit 4
+			if (update_path == "notifications.propulsion.port.commError") {
+
+			} 
+			// Bit 5
+			if (update_path == "notifications.propulsion.port.subOrSecondaryThrottle") {
+
+			} 
+			// Bit 6
+			if (update_path == "notifications.propulsion.port.neutralStartProtect") {
+
+			} 
+			// Bit 7
+			if (update_path == "notifications.propulsion.port.shuttingDown") {
+
+			}
+		}
+
+		// Fluid Levels
+		if (update_path.StartsWith("tanks", NULL)) {
+			tankLevelWatchDog = wxGetLocalTime();
+			wxString xdrunit = "Level";
+
+			// Units are meant to be in percent, but they seem to range from 0 to 1
+			if (update_path == _T("tanks.freshWater.0.currentLevel")) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, GetJsonDouble(value) * 100, xdrunit);
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, GetJsonDouble(value) * 100, xdrunit);
+			}
+
+			if (update_path == _T("tanks.freshWater.1.currentLevel")) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, GetJsonDouble(value) * 100, xdrunit);
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, GetJsonDouble(value) * 100, xdrunit);
+			}
+
+			if (update_path == _T("tanks.freshWater.2.currentLevel")) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, GetJsonDouble(value) * 100, xdrunit);
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, GetJsonDouble(value) * 100, xdrunit);
+			}
+
+			if (update_path == _T("tanks.wasteWater.0.currentLevel")) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, GetJsonDouble(value) * 100, xdrunit);
+			}
+
+			if (update_path == _T("tanks.blackWater.0.currentLevel")) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, GetJsonDouble(value) * 100, xdrunit);
+			}
+
+			if (update_path == _T("tanks.fuel.0.currentLevel")) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, GetJsonDouble(value) * 100, xdrunit);
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, GetJsonDouble(value) * 100, xdrunit);
+			}
+
+			if (update_path == _T("tanks.fuel.1.currentLevel")) {
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, GetJsonDouble(value) * 100, xdrunit);
+				SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, GetJsonDouble(value) * 100, xdrunit);
+			}
+		}
+	}
+}
+
+// SignalK Engine Notifications
+// "state": "normal | alarm"
+// "method: ["visual", "sound"]
+// "message": "Port Enngine Charge Indicator is normal"
+bool DashboardDecoder::CheckAlarmState(wxJSONValue& value) {
+	if (value.HasMember("state")) {
+		if (value["state"].AsString() == "alarm") {
+			return true;
+		}
+	}
+	return false;
+}
+
+void DashboardDecoder::DecodeXDR(wxString &sentence) {
+	m_NMEA0183 << sentence;
+
+	// Handle NMEA 0183 XDR sentences
+	// These are the specific XDR sentences sent by the TwoCan Plugin
+	// XDR Transducer Description		Type	Units
+	// Temperature Transducer			C		C (degrees Celsius)
+	// Pressure Transducer				P		P (Pascal)
+	// Tachometer Transducer			T		R (RPM)
+	// Volume Transducer				V		P (percent capacity) rather than M (cubic metres)
+	// Voltage Transducer				U		V (volts) (for Battery Status, A = Amps)
+	// Generic Transducer				G		H (hours, I use this to display engine hours)
+	// Switch (Not yet implemented)		S		(no units), Names customised for Status 1 & 2 codes 
+
+	if (m_NMEA0183.Parse()) {
+		wxString xdrunit;
+		double xdrdata;
+		// Each NMEA 0183 XDR sentence may have up to 4 items
+		for (int i = 0; i < m_NMEA0183.Xdr.TransducerCnt; i++) {
+			// Copy the NMEA 183 XDR Sentence data element to a variable
+			xdrdata = m_NMEA0183.Xdr.TransducerInfo[i].MeasurementData;
+
+			// Now for each sentence, parse the transducer type, name and units  to determine which gauge to send the data to
+
+			// "T" Engine RPM in unit "R" RPM
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("T")) {
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("R")) {
+					// Update Watchdog timer
+					engineWatchDog = wxGetLocalTime();
+					// Set the units
+					xdrunit = _T("RPM");
+					// TwoCan plugin transducer names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					// NMEA 183 v4.11 transducer names
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					// Ship Modul/Maretron transducer names
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE0")) && (!m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE0")) && (m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, xdrdata, xdrunit);
+					}
+				}
+			}
+
+			// "C" Temperature in "C" degrees Celsius
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("C")) {
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("C")) {
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+						xdrunit = _T("\u00B0 C");
+						// TwoCan transducer naming
+						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						// NMEA 183 v4.11 Transducer Names
+						// Engine Temperature
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						// Engine Exhaust
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, xdrdata, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, xdrdata, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, xdrdata, xdrunit);
+						}
+						// Ship Modul/Maretron Transducer Names
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, xdrdata, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, xdrdata, xdrunit);
+						}
+					}
+					else if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+						xdrunit = _T("\u00B0 F");
+						// TwoCan Transducer naming 
+						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						// NMEA 183 v4.11 Transducer Names
+						// Engine Temperature
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						// Exhaust Temperature
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEEXHAUST#0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						// Ship Modul/Maretron Transducer Names
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGTEMP0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(xdrdata), xdrunit);
+						}
+					}
+				}
+			}
+
+			// "P" Pressure in "P" pascal
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("P")) {
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("P")) {
+					if (m_decodeSettings.pressureUnit == PRESSURE_BAR) {
+						xdrunit = _T("Bar");
+						// TwoCan Transducer naming
+						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						// NMEA 183 v4.11 Transducer Names
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						// Ship Modul/Maretron Transducer Names
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, xdrdata * 1e-5, xdrunit);
+						}
+
+					}
+					else if (m_decodeSettings.pressureUnit == PRESSURE_PSI) {
+						xdrunit = _T("PSI");
+						// TwoCan Plugin Transducer Names
+						if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						// NMEA 183 v4.11 Transducer Names
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEOIL#0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						// Ship Modul/MaretronTransducer Names
+						else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP1")) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (!m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+						else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGOILP0")) && (m_decodeSettings.dualEngine)) {
+							SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(xdrdata), xdrunit);
+						}
+					}
+				}
+			}
+
+			// "U" Voltage in "V" volts
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("U")) {
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("V")) {
+					xdrunit = _T("Volts");
+					// TwoCan Plugin Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STRT")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("HOUS")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, xdrdata, xdrunit);
+					}
+					// NMEA 183 v4.11 Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTERNATOR#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTERNATOR#0")) && (!m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTERNATOR#0")) && (m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, xdrdata, xdrunit);
+					}
+					// Ship Modul/Maretron Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTVOLT1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTVOLT0")) && (!m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ALTVOLT0")) && (m_decodeSettings.dualEngine)) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATVOLT0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATVOLT1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, xdrdata, xdrunit);
+					}
+				}
+				// TwoCan also uses "A" to indicate battery current
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("A")) {
+					xdrunit = _T("Amps");
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STRT")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("HOUS")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, xdrdata, xdrunit);
+					}
+				}
+			}
+
+			// NMEA 0183 V4 standard for current
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("I")) {
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("A")) {
+					xdrunit = _T("Amps");
+					// NMEA 183 v4.11 Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATTERY#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, xdrdata, xdrunit);
+					}
+					// Ship Modul/Maretron Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATCURR0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BATCURR1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_AMPS, xdrdata, xdrunit);
+					}
+				}
+			}
+
+			// "G" Generic - Customised to use "H" as engine hours
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("G")) {
+				// TwoCan uses "H" as unit of measurement 
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("H")) {
+					xdrunit = _T("Hrs");
+					// TwoCan Plugin transducer naming
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("MAIN")) {
+						mainEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("PORT")) {
+						portEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("STBD")) {
+						stbdEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+				}
+				// NMEA 183 v4.11 Transducer Names, Note lack of clarity re transducer names
+				// Note does not have a unit of measurement
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == wxEmptyString) {
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#1")) {
+						xdrunit = _T("Hrs");
+						stbdEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (!m_decodeSettings.dualEngine)) {
+						xdrunit = _T("Hrs");
+						mainEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINE#0")) && (m_decodeSettings.dualEngine)) {
+						xdrunit = _T("Hrs");
+						portEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+				}
+				// NMEA 183 v4.11 Yacht Devices appear to use EngineHours
+				// Note does not have a unit of measurement
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == wxEmptyString) {
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEHOURS#1")) {
+						xdrunit = _T("Hrs");
+						stbdEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEHOURS#0")) && (!m_decodeSettings.dualEngine)) {
+						xdrunit = _T("Hrs");
+						mainEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGINEHOURS#0")) && (m_decodeSettings.dualEngine)) {
+						xdrunit = _T("Hrs");
+						portEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+				}
+				// Ship Modul/Maretron Transducer Names 
+				// Note does not have a unit of measurement
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == wxEmptyString) {
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGHRS1")) {
+						xdrunit = _T("Hrs");
+						stbdEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGHRS0")) && (!m_decodeSettings.dualEngine)) {
+						xdrunit = _T("Hrs");
+						mainEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+					else if ((m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("ENGHRS0")) && (m_decodeSettings.dualEngine)) {
+						xdrunit = _T("Hrs");
+						portEngineHours = xdrdata;
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_HOURS, xdrdata, xdrunit);
+					}
+				}
+
+			}
+
+			// "V" Volume - Customised to use "P" as percent capacity
+			// instead of "M" as volume in cubic metres
+			// Note that NMEA 183 v4.11 standard now introduces 'P' as percent capacity
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("V")) {
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("P")) {
+					// Update Watchdog Timer
+					tankLevelWatchDog = wxGetLocalTime();
+					xdrunit = _T("Level");
+					// TwoCan Plugin Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("FUEL")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("H2O")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("OIL")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("LIVE")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("GREY")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName == _T("BLACK")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
+					}
+					// NMEA 183 v4.11 Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
+					}
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#2")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("OIL#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("LIVEWELLWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("WASTEWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BLACKWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
+					}
+				}
+			}
+			// NMEA 0184 v4.11 Standard for volume with percentage capacity
+			if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerType == _T("E")) {
+				if (m_NMEA0183.Xdr.TransducerInfo[i].UnitOfMeasurement == _T("P")) {
+					// Update Watchdog Timer
+					tankLevelWatchDog = wxGetLocalTime();
+					xdrunit = _T("Level");
+					// NMEA 183 v4.11 Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
+					}
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER#2")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("OIL#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("LIVEWELLWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("WASTEWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BLACKWATER#0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
+					}
+					// Ship Modul/Martron Transducer Names
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, xdrdata, xdrunit);
+					}
+					if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FUEL1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_01, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER1")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_02, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("FRESHWATER2")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_03, xdrdata, xdrunit);
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("OIL0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_OIL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("LIVEWELL0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_LIVEWELL, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("WASTEWATER0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_GREY, xdrdata, xdrunit);
+					}
+					else if (m_NMEA0183.Xdr.TransducerInfo[i].TransducerName.Upper() == _T("BLACKWATER0")) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_TANK_LEVEL_BLACK, xdrdata, xdrunit);
+					}
+				}
+			}
+		}
+	}
+}
+
+void DashboardDecoder::DecodeRPM(wxString &sentence) {
+	m_NMEA0183 << sentence;
+
+	if (m_NMEA0183.Parse()) {
+		if (m_NMEA0183.Rpm.IsDataValid == NTrue) {
+			// Only display engine rpm 'E', not shaft rpm 'S'
+			if (m_NMEA0183.Rpm.Source == _T("E")) {
+				// Update Watchdog Timer
+				engineWatchDog = wxGetLocalTime();
+				// Engine Numbering: 
+				// 0 = Mid-line, Odd = Starboard, Even = Port (numbered from midline)
+				switch (m_NMEA0183.Rpm.EngineNumber) {
+				case 0:
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
+					break;
+				case 1:
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
+					break;
+				case 2:
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
+					break;
+				default:
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, m_NMEA0183.Rpm.RevolutionsPerMinute, "RPM");
+					break;
+				}
+			}
+		}
+	}
+}
+
+void DashboardDecoder::DecodeRSA(wxString &sentence) {
+	m_NMEA0183 << sentence;
+
+	// Plugin does not differentiate dual rudders (port/starboard)
+
+	if (m_NMEA0183.Parse()) {
+		if (m_NMEA0183.Rsa.IsStarboardDataValid == NTrue) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, m_NMEA0183.Rsa.Starboard, _T("\u00B0"));
+		}
+		else if (m_NMEA0183.Rsa.IsPortDataValid == NTrue) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, m_NMEA0183.Rsa.Port, _T("\u00B0"));
+		}
+	}
+}
+
+// Raw NMEA 2000 generated by OpenCPN v5.8
+// Parsing routines cut and pasted from TwoCan Plugin
+// Refer to twocandevice.cpp
+
+// Note the payload is not "the payload" but an entire Actisense payload
+// Actisense application data, from NGT-1 to PC
+// <data code=93><length (1)><priority (1)><PGN (3)><destination(1)><source
+// (1)><time (4)><len (1)><data (len)>
+
+// As applied to a real application data element, after extraction from packet
+// format: 93 13 02 01 F8 01 FF 01 76 C2 52 00 08 08 70 EB 14 E8 8E 52 D2 BB 10
+
+// data code		0x93
+// length (1):      0x13
+// priority (1);    0x02
+// PGN (3):         0x01 0xF8 0x01
+// destination(1):  0xFF
+// source (1):      0x01
+// time (4):        0x76 0xC2 0x52 0x00
+// len (1):         0x08
+// data (len):      08 70 EB 14 E8 8E 52 D2
+// packet CRC:      0xBB
+
+// So to simplify parsing as these are copied from twocan plugin, 
+// use an index into the "real" payload at byte 13 
+
+// PGN 127488 Engine Rapid Update
+void DashboardDecoder::DecodeN2K_127488(const std::vector<uint8_t> &payload) {
+	byte engineInstance;
+	engineInstance = payload[index + 0];
+
+	unsigned short engineSpeed; // RPM in quarter revolutions per minute
+	engineSpeed = payload[index + 1] | (payload[index + 2] << 8);
+
+	unsigned short engineBoostPressure;
+	engineBoostPressure = payload[index + 3] | (payload[index + 4] << 8);
+
+	short engineTrim;
+	engineTrim = payload[index + 5];
+
+	DetectDualEngine(engineInstance);
+
+	engineWatchDog = wxGetLocalTime();
+
+	if (IsDataValid(engineSpeed)) {
+		switch (engineInstance) {
+			case 0:
+				if (m_decodeSettings.dualEngine) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_RPM, engineSpeed * 0.25f, "RPM");
+				}
+				else {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_RPM, engineSpeed * 0.25f, "RPM");
+				}
+				break;
+			case 1:
+				SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_RPM, engineSpeed * 0.25f, "RPM");
+				break;
+		}
+	}
+}
+
+// PGN 127489 Engine Dynamic 
+void DashboardDecoder::DecodeN2K_127489(const std::vector<uint8_t> &payload) {
+	byte engineInstance;
+	engineInstance = payload[index + 0];
+
+	unsigned short oilPressure; // hPa (1 hPa = 100Pa, 1 hPa = .001 Bar)
+	oilPressure = payload[index + 1] | (payload[index + 2] << 8);
+
+	unsigned short oilTemperature; // 0.01 degree resolution, in Kelvin
+	oilTemperature = payload[index + 3] | (payload[index + 4] << 8);
+
+	unsigned short engineTemperature; // 0.01 degree resolution, in Kelvin
+	engineTemperature = payload[index + 5] | (payload[index + 6] << 8);
+
+	unsigned short alternatorPotential; // 0.01 Volts
+	alternatorPotential = payload[index + 7] | (payload[index + 8] << 8);
+
+	unsigned short fuelRate; // 0.1 Litres/hour
+	fuelRate = payload[index + 9] | (payload[index + 10] << 8);
+
+	unsigned int totalEngineHours;  // seconds
+	totalEngineHours = payload[index + 11] | (payload[index + 12] << 8) | (payload[index + 13] << 16) | (payload[index + 14] << 24);
+
+	unsigned short coolantPressure; // hPA
+	coolantPressure = payload[index + 15] | (payload[index + 16] << 8);
+
+	unsigned short fuelPressure; // hPa
+	fuelPressure = payload[index + 17] | (payload[index + 18] << 8);
+
+	unsigned short reserved;
+	reserved = payload[index + 19];
+
+	unsigned short statusOne;
+	statusOne = payload[index + 20] | (payload[index + 21] << 8);
+	// Refer to dial.cpp for which SVG images match fault conditions
+	// {"0": "Check Engine"},
+	// { "1": "Over Temperature" },
+	// { "2": "Low Oil Pressure" },
+	// { "3": "Low Oil Level" },
+	// { "4": "Low Fuel Pressure" },
+	// { "5": "Low System Voltage" },
+	// { "6": "Low Coolant Level" },
+	// { "7": "Water Flow" },
+	// { "8": "Water In Fuel" },
+	// { "9": "Charge Indicator" },
+	// { "10": "Preheat Indicator" },
+	// { "11": "High Boost Pressure" },
+	// { "12": "Rev Limit Exceeded" },
+	// { "13": "EGR System" },
+	// { "14": "Throttle Position Sensor" },
+	// { "15": "Emergency Stop" }]
+
+	unsigned short statusTwo;
+	statusTwo = payload[index + 22] | (payload[index + 23] << 8);
+
+	// {"0": "Warning Level 1"},
+	// { "1": "Warning Level 2" },
+	// { "2": "Power Reduction" },
+	// { "3": "Maintenance Needed" },
+	// { "4": "Engine Comm Error" },
+	// { "5": "Sub or Secondary Throttle" },
+	// { "6": "Neutral Start Protect" },
+	// { "7": "Engine Shutting Down" }]
+
+	byte engineLoad;  // percentage
+	engineLoad = payload[index + 24];
+
+	byte engineTorque; // percentage
+	engineTorque = payload[index + 25];
+
+	DashboardBatch batch;
+
+	DetectDualEngine(engineInstance);
+
+	switch (engineInstance) {
+		case 0:
+			if (m_decodeSettings.dualEngine) {
+				if (IsDataValid(oilPressure)) {
+					if (m_decodeSettings.pressureUnit == PRESSURE_BAR) {
+						batch.Add(OCPN_DBP_STC_PORT_ENGINE_OIL, oilPressure * 1e-3, "Bar");
+					}
+					if (m_decodeSettings.pressureUnit == PRESSURE_PSI) {
+						batch.Add(OCPN_DBP_STC_PORT_ENGINE_OIL, Pascal2Psi(oilPressure * 100), "Psi");
+					}
+				}
+
+				if (IsDataValid(engineTemperature)) {
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+						batch.Add(OCPN_DBP_STC_PORT_ENGINE_WATER, CONVERT_KELVIN((engineTemperature * 0.01f)), _T("\u00B0 C"));
+					}
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+						batch.Add(OCPN_DBP_STC_PORT_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN((engineTemperature * 0.01f))), _T("\u00B0 F"));
+					}
+				}
+			
+				if (IsDataValid(alternatorPotential)) {
+					batch.Add(OCPN_DBP_STC_PORT_ENGINE_VOLTS, alternatorPotential * 0.01, "Volts");
+				}
+
+				if (IsDataValid(totalEngineHours)) {
+					batch.Add(OCPN_DBP_STC_PORT_ENGINE_HOURS, totalEngineHours / 3600.0, "Hrs");
+				}
+
+				if (IsDataValid(statusOne)) {
+					batch.Add(OCPN_DBP_STC_PORT_ENGINE_FAULT_ONE, statusOne, FAULT_STATUS_WORD);
+				}
+			}
+			else {
+				if (IsDataValid(oilPressure)) {
+					if (m_decodeSettings.pressureUnit == PRESSURE_BAR) {
+						batch.Add(OCPN_DBP_STC_MAIN_ENGINE_OIL, oilPressure * 1e-3, "Bar");
+					}
+					if (m_decodeSettings.pressureUnit == PRESSURE_PSI) {
+						batch.Add(OCPN_DBP_STC_MAIN_ENGINE_OIL, Pascal2Psi(oilPressure  * 100), "Psi");
+					}
+				}
+				if (IsDataValid(engineTemperature)) {
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+						batch.Add(OCPN_DBP_STC_MAIN_ENGINE_WATER, CONVERT_KELVIN((engineTemperature * 0.01f)), _T("\u00B0 C"));
+					}
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+						batch.Add(OCPN_DBP_STC_MAIN_ENGINE_WATER, Celsius2Fahrenheit(CONVERT_KELVIN((engineTemperature * 0.01f))), _T("\u00B0 F"));
+					}
+				}
+
+				if (IsDataValid(alternatorPotential)) {
+					batch.Add(OCPN_DBP_STC_MAIN_ENGINE_VOLTS, alternatorPotential * 0.01, "Volts");
+				}
+
+				if (IsDataValid(totalEngineHours)) {
+					batch.Add(OCPN_DBP_STC_MAIN_ENGINE_HOURS, totalEngineHours / 3600.0, "Hrs");
+				}
+
+				if (IsDataValid(statusOne)) {
+					batch.Add(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, statusOne, FAULT_STATUS_WORD);
+				}
+			}
+			break;
+		case 1:
+			if (IsDataValid(oilPressure)) {
+				if (m_decodeSettings.pressureUnit == PRESSURE_BAR) {
+					batch.Add(OCPN_DBP_STC_STBD_ENGINE_OIL, oilPressure * 1e-3, "Bar");
+				}
+				if (m_decodeSettings.pressureUnit == PRESSURE_PSI) {
+					batch.Add(OCPN_DBP_STC_STBD_ENGINE_OIL, Pascal2Psi(oilPressure * 100), "Psi");
+				}
+			}
+			if (IsDataValid(engineTemperature)) {
+				if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+					batch.Add(OCPN_DBP_STC_STBD_ENGINE_WATER, CONVERT_KELVIN((engineTemperature * 0.01f)), _T("\u00B0 C"));
+				}
+				if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+					batch.Add(OCPN_DBP_STC_STBD_ENGINE_WATER, Celsius2Fahrenheit((CONVERT_KELVIN(engineTemperature * 0.01f))), _T("\u00B0 F"));
+				}
+			}
+
+			if (IsDataValid(alternatorPotential)) {
+				batch.Add(OCPN_DBP_STC_STBD_ENGINE_VOLTS, alternatorPotential * 0.01, "Volts");
+			}
+
+			if (IsDataValid(totalEngineHours)) {
+				batch.Add(OCPN_DBP_STC_STBD_ENGINE_HOURS, totalEngineHours / 3600.0, "Hrs");
+			}
+
+			if (IsDataValid(statusOne)) {
+				batch.Add(OCPN_DBP_STC_STBD_ENGINE_FAULT_ONE, statusOne, FAULT_STATUS_WORD);
+			}
+
+			break;
+		}
+
+	SendBatchToAllInstruments(batch);
+}
+
+// PGN 127505 Fluid Levels
+void DashboardDecoder::DecodeN2K_127505(const std::vector<uint8_t> &payload) {
+	byte instance;
+	instance = payload[index + 0] & 0x0F;
+
+	byte tankType;
+	tankType = (payload[index + 0] & 0xF0) >> 4;
+
+	unsigned short tankLevel; // percentage in 0.025 increments
+	tankLevel = payload[index + 1] | (payload[index + 2] << 8);
+
+	unsigned int tankCapacity; // 0.1 L
+	tankCapacity = payload[index + 3] | (payload[index + 4] << 8) | (payload[index + 5] << 16) | (payload[index + 6] << 24);
+
+	tankLevelWatchDog = wxGetLocalTime();
+
+	DashboardBatch batch;
+
+	if (IsDataValid(tankLevel)) {
+
+		switch (tankType) {
+			case 0: // Fuel
+				if (instance == 0) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_FUEL_01, tankLevel / 250, "Level");
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, tankLevel / 250, "Level");
+				}
+				if (instance == 1) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_FUEL_02, tankLevel / 250, "Level");
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_02, tankLevel / 250, "Level");
+				}
+				break;
+			case 1: // Freshwater
+				if (instance == 0) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_WATER_01, tankLevel / 250, "Level");
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, tankLevel / 250, "Level");
+				}
+				if (instance == 1) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_WATER_02, tankLevel / 250, "Level");
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_02, tankLevel / 250, "Level");
+				}
+				if (instance == 2) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_WATER_03, tankLevel / 250, "Level");
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_03, tankLevel / 250, "Level");
+				}
+				break;
+			case 2: // Waste water
+				if (instance == 0) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_GREY, tankLevel / 250, "Level");
+				}
+				break;
+			case 4: // Oil
+				if (instance == 0) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_OIL, tankLevel / 250, "Level");
+				}
+				break;
+			case 5: // Blackwater
+				if (instance == 0) {
+					batch.Add(OCPN_DBP_STC_TANK_LEVEL_BLACK, tankLevel / 250, "Level");
+				}
+				break;
+			}
+	}
+
+	SendBatchToAllInstruments(batch);
+}
+
+// PGN 127508 Battery Status
+void DashboardDecoder::DecodeN2K_127508(const std::vector<uint8_t> &payload) {
+	byte batteryInstance;
+	batteryInstance = payload[index + 0];
+
+	unsigned short batteryVoltage; // 0.01 volts
+	batteryVoltage = payload[index + 1] | (payload[index + 2] << 8);
+
+	short batteryCurrent; // 0.1 amps	
+	batteryCurrent = payload[index + 3] | (payload[index + 4] << 8);
+
+	unsigned short batteryTemperature; // 0.01 degree resolution, in Kelvin
+	batteryTemperature = payload[index + 5] | (payload[index + 6] << 8);
+
+	byte sid;
+	sid = payload[index + 7];
+
+	if ((IsDataValid(batteryVoltage)) && (IsDataValid(batteryCurrent))) {
+
+		if (batteryInstance == 0) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, batteryVoltage * 0.01f, "Volts");
+			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_AMPS, batteryCurrent * 0.1f, "Amps");
+		}
+
+		if (batteryInstance == 1) {
+			SendSentenceToAllInstruments(OCPN_DBP_STC_HOUSE_BATTERY_VOLTS, batteryVoltage * 0.01f, "Volts");
+			SendSentenceToAllInstruments(OCPN_DBP_STC_START_BATTERY_VOLTS, batteryCurrent * 0.1f, "Amps");
+		}
+	}
+	
+}
+
+// PGN 130312 Temperature (used for Exhaust Gas Temperature)
+void DashboardDecoder::DecodeN2K_130312(const std::vector<uint8_t> &payload) {
+	byte sid;
+	sid = payload[index + 0];
+
+	byte engineInstance;
+	engineInstance = payload[index + 1];
+
+	byte source;
+	source = payload[index + 2];
+
+	unsigned short actualTemperature;
+	actualTemperature = payload[index + 3] | (payload[index + 4] << 8);
+
+	unsigned short setTemperature;
+	setTemperature = payload[index + 5] | (payload[index + 6] << 8);
+
+	DetectDualEngine(engineInstance);
+
+	// Source 14 indicates exhaust temperature
+	if ((source == 14) && (IsDataValid(actualTemperature))) {
+
+		switch (engineInstance) {
+			case 0:
+				if (m_decodeSettings.dualEngine) {
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, CONVERT_KELVIN((actualTemperature * 0.01f)), _T("\u00B0 C"));
+					}
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_PORT_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN((actualTemperature * 0.01f))), _T("\u00B0 F"));
+					}
+				}
+				else {
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, CONVERT_KELVIN((actualTemperature * 0.01f)), _T("\u00B0 C"));
+					}
+					if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+						SendSentenceToAllInstruments(OCPN_DBP_STC_MAIN_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN((actualTemperature * 0.01f))), _T("\u00B0 F"));
+					}
+				}
+				break;
+			case 1:
+				if (m_decodeSettings.temperatureUnit == TEMPERATURE_CELSIUS) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, CONVERT_KELVIN((actualTemperature * 0.01f)), _T("\u00B0 C"));
+				}
+				if (m_decodeSettings.temperatureUnit == TEMPERATURE_FAHRENHEIT) {
+					SendSentenceToAllInstruments(OCPN_DBP_STC_STBD_ENGINE_EXHAUST, Celsius2Fahrenheit(CONVERT_KELVIN((actualTemperature * 0.01f))), _T("\u00B0 F"));
+				}
+				break;
+		}
+	}
+}
+
+// PGN 127245 Rudder Angle 
+void DashboardDecoder::DecodeN2K_127245(const std::vector<uint8_t> &payload) {
+	byte instance;
+	instance = payload[index + 0];
+
+	byte directionOrder;
+	directionOrder = payload[index + 1] & 0x03;
+
+	short angleOrder; // 0.0001 radians
+	angleOrder = payload[index + 2] | (payload[index + 3] << 8);
+
+	short position; // 0.0001 radians
+	position = payload[index + 4] | (payload[index + 5] << 8);
+
+	if (IsDataValid(position)) {
+		// Ignore rudder instance assume that it refers to the main rudder
+		SendSentenceToAllInstruments(OCPN_DBP_STC_RSA, RADIANS_TO_DEGREES((float)position * 1e-4), _T("\u00B0"));
+	}
+}
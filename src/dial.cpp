@@ -42,6 +42,7 @@
 
 
 #include "dial.h"
+#include "glyph_atlas.h"
 //#include "wx28compat.h"
 
 // For compilers that support precompilation, includes "wx/wx.h".
@@ -58,7 +59,7 @@
 #endif
 
 #include <cmath>
-#include "wx/tokenzr.h"
+#include <map>
 
 double rad2deg(double angle) {
       return angle*180.0/M_PI;
@@ -67,6 +68,55 @@ double deg2rad(double angle) {
       return angle/180.0*M_PI;
 }
 
+// Refer to dashboard_pi.cpp, PGN 127489, for the fault conditions
+static const wxChar *warningIconFiles[] = {
+    _T("engine.svg"),        // Check Engine
+    _T("temperature.svg"),   // Over Temperature
+    _T("oil.svg"),           // Low Oil Pressure
+    _T("oil-level.svg"),     // Low Oil Level
+    _T("fuel.svg"),          // Low Fuel Pressure
+    _T("battery.svg"),       // Low System Voltage
+    _T("coolant.svg"),       // Low Coolant Level
+    _T("water.svg"),         // Water Flow
+    _T("contamination.svg"), // Water In Fuel
+    _T("alternator.svg"),    // Charge Indicator
+    _T("preheat.svg"),       // Preheat Indicator
+    _T("turbo.svg"),         // High Boost Pressure
+    _T("rev-limit.svg"),     // Rev Limit Exceeded
+    _T("exhaust.svg"),       // EGR System
+    _T("throttle.svg"),      // Throttle Position Sensor
+    _T("stop.svg")           // Emergency Stop
+};
+
+// Every alarm icon rasterized at one size for one colour scheme
+struct WarningIconAtlas {
+    wxBitmap icons[WARNING_ICON_COUNT];
+};
+
+// Atlases are rasterized on first use, keyed by size, content scale and colour scheme,
+// so displaying several alarms costs no more than displaying one
+static std::map<unsigned int, WarningIconAtlas> warningIconAtlases;
+
+const wxBitmap &GetWarningIcon(int icon, int dimension, double scale) {
+    unsigned int key = ((unsigned int)g_ColorScheme << 24) | ((unsigned int)wxRound(scale * 100) << 12) | (unsigned int)dimension;
+    std::map<unsigned int, WarningIconAtlas>::iterator it = warningIconAtlases.find(key);
+    if (it == warningIconAtlases.end()) {
+        it = warningIconAtlases.insert(std::make_pair(key, WarningIconAtlas())).first;
+        int pixels = wxRound(dimension * scale);
+        for (int i = 0; i < WARNING_ICON_COUNT; i++) {
+            wxBitmap bitmap = GetBitmapFromSVGFile(iconFolder + warningIconFiles[i], pixels, pixels);
+#if wxCHECK_VERSION(3, 1, 6) && !defined(__WXMSW__)
+            if ((scale != 1.0) && bitmap.IsOk()) {
+                // Drawn at the logical dimension
+                bitmap = wxBitmap(bitmap.ConvertToImage(), wxBITMAP_SCREEN_DEPTH, scale);
+            }
+#endif
+            it->second.icons[i] = bitmap;
+        }
+    }
+    return it->second.icons[icon];
+}
+
 DashboardInstrument_Dial::DashboardInstrument_Dial(wxWindow *parent, wxWindowID id, wxString title, DASH_CAP cap_flag,
                   int s_angle, int r_angle, int s_value, int e_value) : DashboardInstrument(parent, id, title, cap_flag) {
       m_AngleStart = s_angle;
@@ -76,11 +126,16 @@ DashboardInstrument_Dial::DashboardInstrument_Dial(wxWindow *parent, wxWindowID
       m_MainValueCap = cap_flag;
 
       m_MainValue = s_value;
+      m_NeedleValue = s_value;
+      m_NeedleVelocity = 0;
+      m_NeedleDamping = 0.4;
+      m_NeedleMoving = false;
+      m_NeedleTime = 0;
       m_ExtraValue = 0;
-      m_MainValueFormat = _T("%d");
+      m_MainValueFormatter.SetFormat(_T("%d"));
       m_MainValueUnit = _T("");
       m_MainValueOption = DIAL_POSITION_NONE;
-      m_ExtraValueFormat = _T("%d");
+      m_ExtraValueFormatter.SetFormat(_T("%d"));
       m_ExtraValueUnit = _T("");
       m_ExtraValueOption = DIAL_POSITION_NONE;
       m_MarkerOption = DIAL_MARKER_SIMPLE;
@@ -89,6 +144,22 @@ DashboardInstrument_Dial::DashboardInstrument_Dial(wxWindow *parent, wxWindowID
       m_MarkerOffset = 1;
       m_LabelOption = DIAL_LABEL_HORIZONTAL;
       m_LabelArray = wxArrayString();
+      m_staticScheme = g_ColorScheme;
+      m_staticQuality = QUALITY_FULL;
+      m_spriteScheme = g_ColorScheme;
+      m_spriteScale = 1.0;
+      m_spriteLabelOption = DIAL_LABEL_NONE;
+      m_staticCx = 0;
+      m_staticCy = 0;
+      m_staticRadius = 0;
+      m_staticTitleHeight = 0;
+      InvalidateGeometry();
+      m_warningStatus = 0;
+      m_warningsPainted = false;
+      m_damageValid = false;
+      for (int i = 0; i < WARNING_ICON_COUNT; i++) {
+          m_warningTimes[i] = 0;
+      }
 }
 
 DashboardInstrument_Dial::~DashboardInstrument_Dial(void) {
@@ -98,23 +169,27 @@ void DashboardInstrument_Dial::SetOptionMarker(double step, DialMarkerOption opt
 	m_MarkerStep = step; 
 	m_MarkerOption = option; 
 	m_MarkerOffset = offset; 
+	m_staticLayer = wxNullBitmap;
+	InvalidateGeometry();
 }
 
 void DashboardInstrument_Dial::SetOptionLabel(double step, DialLabelOption option, wxArrayString labels) { 
 	m_LabelStep = step; 
 	m_LabelOption = option; 
 	m_LabelArray = labels;
+	m_staticLayer = wxNullBitmap;
+	InvalidateGeometry();
 }
 
 void DashboardInstrument_Dial::SetOptionMainValue(wxString format, DialPositionOption option) {
-	m_MainValueFormat = format; 
+	m_MainValueFormatter.SetFormat(format);
 	m_MainValueOption = option;
 }
 
 void DashboardInstrument_Dial::SetOptionExtraValue(DASH_CAP cap, wxString format, DialPositionOption option) {
 	m_ExtraValueCap = cap; 
 	m_cap_flag.set(cap); 
-	m_ExtraValueFormat = format; 
+	m_ExtraValueFormatter.SetFormat(format);
 	m_ExtraValueOption = option;
 }
 
@@ -124,9 +199,8 @@ void DashboardInstrument_Dial::SetOptionWarningValue(DASH_CAP cap) {
 }
 
 wxSize DashboardInstrument_Dial::GetSize(int orient, wxSize hint) {
-      wxClientDC dc(this);
       int w;
-      dc.GetTextExtent(m_title, &w, &m_TitleHeight, 0, 0, g_pFontTitle);
+      GetCachedTextExtent(m_title, g_pFontTitle, &w, &m_TitleHeight);
       if (orient == wxHORIZONTAL) {
           w = wxMax(hint.y, DefaultWidth+m_TitleHeight);
           return wxSize(w-m_TitleHeight, w);
@@ -141,267 +215,449 @@ void DashboardInstrument_Dial::SetData(DASH_CAP st, double data, wxString unit)
     if (st == m_MainValueCap) {
         m_MainValue = data;
         m_MainValueUnit = unit;
+        StartNeedle();
     }
     else if (st == m_ExtraValueCap) {
         m_ExtraValue = data;
         m_ExtraValueUnit = unit;
     }
     else if (st == m_WarningValueCap) {
-        // These are bit values set from a 2 byte value
-        // BUG BUG Unsure if it is possible to have multiple alarms
-        switch ((int)data) {
-        case 1: // "Check Engine" 
-            imageFilename = "engine.svg";
-            break;
-        case 2: // "Over Temperature" 
-            imageFilename = "temperature.svg";
-            break;
-        case 4: // "Low Oil Pressure" 
-            imageFilename = "oil.svg";
-            break;
-        case 8: // "Low Oil Level"
-            imageFilename = "oil-level.svg";
-            break;
-        case 16: // "Low Fuel Pressure" 
-            imageFilename = "fuel.svg";
+        // These are bit values set from a 2 byte value, each bit is a separate alarm.
+        // NMEA 2000 sends the entire word, which replaces the alarms displayed.
+        // SignalK sends one alarm at a time, so those alarms accumulate until they are no longer reported.
+        unsigned int status = (unsigned int)data & 0xFFFF;
+        if (unit == FAULT_STATUS_WORD) {
+            m_warningStatus = status;
+        }
+        else {
+            m_warningStatus |= status;
+        }
+        wxLongLong now = wxGetLocalTimeMillis();
+        for (int bit = 0; bit < WARNING_ICON_COUNT; bit++) {
+            if (status & (1 << bit)) {
+                m_warningTimes[bit] = now;
+            }
+        }
+    }
+}
+
+// Called whenever m_MainValue changes, the needle then follows it on each animation frame
+void DashboardInstrument_Dial::StartNeedle(void) {
+    // No data (NaN) cannot be animated to or from, the needle is placed immediately
+    if ((m_NeedleDamping <= 0) || std::isnan(m_MainValue) || std::isnan(m_NeedleValue)) {
+        m_NeedleValue = m_MainValue;
+        m_NeedleVelocity = 0;
+        m_NeedleMoving = false;
+        return;
+    }
+    if (!m_NeedleMoving) {
+        m_NeedleTime = wxGetLocalTimeMillis();
+        m_NeedleMoving = (m_NeedleValue != m_MainValue);
+    }
+}
+
+// Move the needle towards m_MainValue using a critically damped spring, so that it
+// accelerates smoothly and settles without overshoot. Returns true if still moving.
+bool DashboardInstrument_Dial::Animate(wxLongLong now) {
+    if (!m_NeedleMoving) {
+        return false;
+    }
+
+    if (std::isnan(m_MainValue) || std::isnan(m_NeedleValue)) {
+        m_NeedleValue = m_MainValue;
+        m_NeedleVelocity = 0;
+        m_NeedleMoving = false;
+        RefreshDamage();
+        return false;
+    }
+
+    // Limit the step, so that a stalled timer does not cause the needle to jump
+    double dt = wxMin((now - m_NeedleTime).ToDouble() / 1000.0, 0.1);
+    m_NeedleTime = now;
+    if (dt <= 0) {
+        return true;
+    }
+
+    double omega = 2.0 / m_NeedleDamping;
+    double x = omega * dt;
+    double decay = 1.0 / (1.0 + x + 0.48 * x * x + 0.235 * x * x * x);
+    double change = m_NeedleValue - m_MainValue;
+    double temp = (m_NeedleVelocity + omega * change) * dt;
+    m_NeedleVelocity = (m_NeedleVelocity - omega * temp) * decay;
+    m_NeedleValue = m_MainValue + (change + temp) * decay;
+
+    double threshold = GetValueSpan() * ANIMATION_SETTLE_THRESHOLD;
+    if ((fabs(m_NeedleValue - m_MainValue) < threshold) && (fabs(m_NeedleVelocity) * dt < threshold)) {
+        m_NeedleValue = m_MainValue;
+        m_NeedleVelocity = 0;
+        m_NeedleMoving = false;
+    }
+
+    RefreshDamage();
+    return m_NeedleMoving;
+}
+
+void DashboardInstrument_Dial::Draw(wxGCDC* bdc) {
+    wxSize size = GetClientSize();
+    if (!IsStaticLayerValid(size)) {
+        RenderStaticLayer(size);
+    }
+
+    bdc->DrawBitmap(m_staticLayer, 0, 0, false);
+    // DrawFrame may have moved the centre, eg. Rudder Angle
+    m_cx = m_staticCx;
+    m_cy = m_staticCy;
+    m_radius = m_staticRadius;
+
+    DrawWarning(bdc);
+    m_dataRect = wxRect();
+    DrawData(bdc, m_MainValue, m_MainValueUnit, m_MainValueFormatter, m_MainValueOption);
+    DrawData(bdc, m_ExtraValue, m_ExtraValueUnit, m_ExtraValueFormatter, m_ExtraValueOption);
+    DrawForeground(bdc);
+    m_needleRect = GetNeedleRect();
+    m_damageValid = true;
+}
+
+// The needle's previous and current positions, and the rows containing the values.
+// Warnings are overlaid on the dial, so the entire dial is repainted whilst any are shown.
+wxRect DashboardInstrument_Dial::GetDamageRect(void) {
+    wxSize size = GetClientSize();
+    if (!m_damageValid || (m_warningStatus != 0) || m_warningsPainted || !IsStaticLayerValid(size)) {
+        return GetClientRect();
+    }
+
+    wxRect rect = m_needleRect;
+    rect.Union(GetNeedleRect());
+    if (!m_dataRect.IsEmpty()) {
+        // The width of the text varies with the value
+        rect.Union(wxRect(0, m_dataRect.y, size.x, m_dataRect.height));
+    }
+    return rect;
+}
+
+wxRect DashboardInstrument_Dial::GetNeedleRect(void) {
+    wxPoint points[4];
+    GetNeedlePoints(points);
+    wxRect rect(points[0], points[0]);
+    for (int i = 1; i < 4; i++) {
+        rect.Union(wxRect(points[i], points[i]));
+    }
+    // Allow for anti-aliasing and rounding
+    return rect.Inflate(2);
+}
+
+bool DashboardInstrument_Dial::IsStaticLayerValid(wxSize size) {
+    return IsScaledBitmapValid(m_staticLayer, size, GetContentScale(this))
+        && (m_staticTitleHeight == m_TitleHeight) && (m_staticScheme == g_ColorScheme) && (m_staticFont == *g_pFontSmall)
+        && (m_staticQuality == GetRenderQuality());
+}
+
+// Centre and radius of the dial below the title, before any adjustment by DrawFrame
+void DashboardInstrument_Dial::LayoutDial(wxSize size) {
+    m_cx = size.x / 2;
+    int availableHeight = size.y - m_TitleHeight - 6;
+    m_cy = m_TitleHeight + 2;
+    m_cy += availableHeight / 2;
+    m_radius = availableHeight / 2;
+}
+
+// Draws one phase in isolation. The dial is laid out as it is for the static layer,
+// so the phases that follow DrawFrame see the same centre as they do when painted.
+void DashboardInstrument_Dial::DrawPhase(wxGCDC *dc, DialDrawPhase phase) {
+    LayoutDial(GetClientSize());
+    switch (phase) {
+        case DIAL_PHASE_LABELS:
+            DrawLabels(dc);
             break;
-        case 32: // "Low System Voltage" 
-            imageFilename = "battery.svg";
+        case DIAL_PHASE_FRAME:
+            DrawFrame(dc);
             break;
-        case 64: // "Low Coolant Level" 
-            imageFilename = "coolant.svg";
+        case DIAL_PHASE_MARKERS:
+            DrawMarkers(dc);
             break;
-        case 128: // "Water Flow" 
-            imageFilename = "water.svg";
+        case DIAL_PHASE_BACKGROUND:
+            DrawBackground(dc);
             break;
-        case 256: // "Water In Fuel" 
-            imageFilename = "contamination.svg";
+        case DIAL_PHASE_WARNING:
+            DrawWarning(dc);
             break;
-        case 512: // "Charge Indicator"
-            imageFilename = "alternator.svg";
+        case DIAL_PHASE_DATA:
+            m_dataRect = wxRect();
+            DrawData(dc, m_MainValue, m_MainValueUnit, m_MainValueFormatter, m_MainValueOption);
+            DrawData(dc, m_ExtraValue, m_ExtraValueUnit, m_ExtraValueFormatter, m_ExtraValueOption);
             break;
-        case 1024: // "Preheat Indicator" 
-            imageFilename = "preheat.svg";
+        case DIAL_PHASE_FOREGROUND:
+            DrawForeground(dc);
             break;
-        case 2048: // "High Boost Pressure" 
-            imageFilename = "turbo.svg";
+        default:
             break;
-        case 4096: // "Rev Limit Exceeded"
-            imageFilename = "rev-limit.svg";
+    }
+}
+
+// Draw the parts of the dial that do not change with its value
+void DashboardInstrument_Dial::RenderStaticLayer(wxSize size) {
+    CreateScaledBitmap(m_staticLayer, size, GetContentScale(this));
+    wxMemoryDC mdc(m_staticLayer);
+    wxGCDC bdc(mdc);
+    if ((GetRenderQuality() >= QUALITY_NO_ANTIALIAS) && bdc.GetGraphicsContext()) {
+        bdc.GetGraphicsContext()->SetAntialiasMode(wxANTIALIAS_NONE);
+    }
+
+    wxColour c1;
+    c1 = g_Palette.background;
+    wxBrush b1(c1);
+    bdc.SetBackground(b1);
+    bdc.Clear();
+
+    LayoutDial(size);
+    DrawLabels(&bdc);
+    DrawFrame(&bdc);
+    DrawMarkers(&bdc);
+    DrawBackground(&bdc);
+
+    m_staticCx = m_cx;
+    m_staticCy = m_cy;
+    m_staticRadius = m_radius;
+    m_staticTitleHeight = m_TitleHeight;
+    m_staticScheme = g_ColorScheme;
+    m_staticFont = *g_pFontSmall;
+    m_staticQuality = GetRenderQuality();
+    mdc.SelectObject(wxNullBitmap);
+}
+
+void DashboardInstrument_Dial::DrawWarning(wxGCDC* dc) {
+// If there are engine alarms overlay the dial with a row, or grid, of icons
+// An alarm is removed if it is no longer reported
+    m_warningsPainted = false;
+    if (m_warningStatus == 0) {
+        return;
+    }
+
+    wxLongLong now = wxGetLocalTimeMillis();
+    int count = 0;
+    for (int bit = 0; bit < WARNING_ICON_COUNT; bit++) {
+        if (m_warningStatus & (1 << bit)) {
+            if (now - m_warningTimes[bit] > WARNING_TIMEOUT) {
+                m_warningStatus &= ~(1 << bit);
+            }
+            else {
+                count++;
+            }
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+    m_warningsPainted = true;
+
+    // Reduce the icons until all of the alarms fit in the upper part of the dial
+    wxSize size = GetClientSize();
+    double scale = GetContentScale(this);
+    // Chosen by the logical size, the icons are rasterized for the display's scale
+    int dimension = size.x > 300 ? 96 : size.x > 200 ? 48 : 32;
+    int columns, rows;
+    while (true) {
+        columns = wxMin(wxMax((size.x * 3 / 4) / dimension, 1), count);
+        rows = (count + columns - 1) / columns;
+        if ((rows * dimension <= size.y / 3) || (dimension <= WARNING_ICON_MIN_SIZE)) {
             break;
-        case 8192: // "EGR System" 
-            imageFilename = "exhaust.svg";
+        }
+        dimension = wxMax(dimension / 2, WARNING_ICON_MIN_SIZE);
+    }
+
+    int top = (size.y / 3) - (dimension / 3);
+    int i = 0;
+    for (int bit = 0; bit < WARNING_ICON_COUNT; bit++) {
+        if (m_warningStatus & (1 << bit)) {
+            int row = i / columns;
+            int column = i % columns;
+            int iconsInRow = wxMin(columns, count - (row * columns));
+            int left = (size.x / 2) - ((iconsInRow * dimension) / 2);
+            dc->DrawBitmap(GetWarningIcon(bit, dimension, scale), left + (column * dimension), top + (row * dimension));
+            i++;
+        }
+    }
+}
+
+DialGeometryKey DashboardInstrument_Dial::GetGeometryKey(void) {
+    DialGeometryKey key;
+    key.cx = m_cx;
+    key.cy = m_cy;
+    key.radius = m_radius;
+    key.width = GetClientSize().x;
+    return key;
+}
+
+void DashboardInstrument_Dial::InvalidateGeometry(void) {
+    DialGeometryKey invalid = { 0, 0, -1, 0 };
+    m_markerKey = invalid;
+    m_arcKey = invalid;
+    m_labelsValid = false;
+    m_spritesValid = false;
+}
+
+void DashboardInstrument_Dial::AddArc(DialArcColour colour, double startAngle, double endAngle, int radius) {
+    DialArc arc;
+    arc.start = wxPoint(m_cx + (radius * cos(deg2rad(startAngle))), m_cy + (radius * sin(deg2rad(startAngle))));
+    arc.end = wxPoint(m_cx + (radius * cos(deg2rad(endAngle))), m_cy + (radius * sin(deg2rad(endAngle))));
+    arc.colour = colour;
+    m_arcs.push_back(arc);
+}
+
+// Warning arc, followed by the outer ring
+void DashboardInstrument_Dial::UpdateArcs(void) {
+    m_arcKey = GetGeometryKey();
+    m_arcs.clear();
+
+    int penwidth = 1 + m_arcKey.width / 100;
+    int radi = m_radius - 1 - penwidth;
+
+    // BUG BUG Implement LOW & HIGH WARNING
+    switch (m_MarkerOption) {
+        case DIAL_MARKER_WARNING_LOW:
+            AddArc(DIAL_ARC_RED, 168, 135, radi); // 135 + 1/8 of270, 90 + 45
             break;
-        case 16384: // "Throttle Position Sensor" 
-            imageFilename = "throttle.svg";
+        case DIAL_MARKER_WARNING_HIGH:
+            AddArc(DIAL_ARC_RED, 45, 12, radi); // 45, 45 - 1/8 of 270
             break;
-        case 32768: // "Emergency Stop" 
-            imageFilename = "stop.svg";
+        //  For battery status
+        case DIAL_MARKER_GREEN_MID:
+            AddArc(DIAL_ARC_GREEN, 330, 270, radi); // 270 + 1/4 of 270, 270
             break;
-        default: // In case there are multiple alarms
-            imageFilename = "default.svg";
+        case DIAL_MARKER_REDGREENBAR:
+            AddArc(DIAL_ARC_RED, 270, 90, radi);
+            AddArc(DIAL_ARC_GREEN, 89, 271, radi);
             break;
-        }
+        default:
+            // Plain circle, no arcs
+            return;
     }
+
+    // Some platforms have trouble with transparent pen.
+    // so we simply draw arcs for the outer ring.
+    AddArc(DIAL_ARC_FRAME, 0, 180, m_radius - 1);
+    AddArc(DIAL_ARC_FRAME, 180, 0, m_radius - 1);
 }
 
-void DashboardInstrument_Dial::Draw(wxGCDC* bdc) {
-    wxColour c1;
-    GetGlobalColor(_T("DASHB"), &c1);
-    wxBrush b1(c1);
-    bdc->SetBackground(b1);
-    bdc->Clear();
+void DashboardInstrument_Dial::UpdateMarkers(void) {
+    m_markerKey = GetGeometryKey();
+    m_markers.clear();
 
-    wxSize size = GetClientSize();
-    m_cx = size.x / 2;
-    int availableHeight = size.y - m_TitleHeight - 6;
-    int width, height;
-    bdc->GetTextExtent(_T("000"), &width, &height, 0, 0, g_pFontLabel);
-    m_cy = m_TitleHeight + 2;
-    m_cy += availableHeight / 2;
-    m_radius = availableHeight / 2;
+    int diff_angle = m_AngleStart + m_AngleRange - ANGLE_OFFSET;
+    // angle between markers
+    double abm = m_AngleRange * m_MarkerStep / (m_MainValueMax - m_MainValueMin);
+    // don't draw last value, it's already done as first
+    if (m_AngleRange == 360) diff_angle -= abm;
 
+    int offset = 0;
+    for (double angle = m_AngleStart - ANGLE_OFFSET; angle <= diff_angle; angle += abm) {
+        double size = 0.92;
+        bool minor = (offset % m_MarkerOffset) != 0;
+        if (minor) {
+            size = 0.96;
+        }
+        offset++;
 
-    DrawLabels(bdc);
-    DrawFrame(bdc);
-    DrawMarkers(bdc);
-    DrawBackground(bdc);
-    DrawWarning(bdc);
-    DrawData(bdc, m_MainValue, m_MainValueUnit, m_MainValueFormat, m_MainValueOption);
-    DrawData(bdc, m_ExtraValue, m_ExtraValueUnit, m_ExtraValueFormat, m_ExtraValueOption);
-    DrawForeground(bdc);
+        double cosine = cos(deg2rad(angle));
+        double sine = sin(deg2rad(angle));
+        DialMarker marker;
+        marker.inner = wxPoint(m_cx + ((m_radius-1) * size * cosine), m_cy + ((m_radius-1) * size * sine));
+        marker.outer = wxPoint(m_cx + ((m_radius-1) * cosine), m_cy + ((m_radius-1) * sine));
+        marker.angle = int(angle + ANGLE_OFFSET) % 360;
+        marker.minor = minor;
+        m_markers.push_back(marker);
+    }
 }
 
-void DashboardInstrument_Dial::DrawWarning(wxGCDC* dc) {
-// If there's an engine alarm overlay the dial with an icon
-// Delete the image string so that if the alarm ceases, an icon is no longer displayed
-    if (!imageFilename.IsEmpty()) {
-        wxSize size = GetClientSize();
-        int dimension = size.x > 300 ? 96 : size.x > 200 ? 48 : 32;
-        imageFilename.Prepend(iconFolder);
-        wxBitmap imageBitmap = GetBitmapFromSVGFile(imageFilename, dimension, dimension);
-        dc->DrawBitmap(imageBitmap, (size.x/2) - (dimension/2), (size.y/3) - (dimension/3) );
-        imageFilename.Empty();
+// Label text and direction, independent of the size of the dial
+void DashboardInstrument_Dial::UpdateLabels(void) {
+    m_labelsValid = true;
+    m_labels.clear();
+
+    int diff_angle = m_AngleStart + m_AngleRange - ANGLE_OFFSET;
+    // angle between markers
+    double abm = m_AngleRange * m_LabelStep / (m_MainValueMax - m_MainValueMin);
+    // don't draw last value, it's already done as first
+    if (m_AngleRange == 360) diff_angle -= abm;
+
+    int offset = 0;
+    int value = m_MainValueMin;
+    wxString label;
+
+    for (double angle = m_AngleStart - ANGLE_OFFSET; angle <= diff_angle; angle += abm) {
+        if (m_LabelOption == DIAL_LABEL_FRACTIONS) {
+            if (value == 0) {
+                label = "0";
+            }
+            if (value == 25) {
+                label = "1/4";
+            }
+            if (value == 50) {
+                label = "1/2";
+            }
+            if (value == 75) {
+                label = "3/4";
+            }
+            if (value == 100) {
+                label = "4/4";
+            }
+        }
+        else {
+            label = (m_LabelArray.GetCount() ? m_LabelArray.Item(offset) : wxString::Format(_T("%d"), value));
+        }
+
+        DialLabel dialLabel;
+        dialLabel.angle = angle;
+        dialLabel.cosine = cos(deg2rad(angle));
+        dialLabel.sine = sin(deg2rad(angle));
+        dialLabel.text = label;
+        m_labels.push_back(dialLabel);
+
+        offset++;
+        value += m_LabelStep;
     }
 }
 
 void DashboardInstrument_Dial::DrawFrame(wxGCDC* dc) {
     wxSize size = GetClientSize();
     wxColour cl;
-    GetGlobalColor(_T("DASHL"), &cl);
+    cl = g_Palette.title;
     dc->SetTextForeground(cl);
     dc->SetBrush(*wxTRANSPARENT_BRUSH);
     
     int penwidth = 1 + size.x / 100;
     wxPen pen(cl, penwidth, wxPENSTYLE_SOLID);
 
-	// BUG BUG Implement LOW & HIGH WARNING
-	if (m_MarkerOption == DIAL_MARKER_WARNING_LOW) {
-		pen.SetWidth(penwidth * 2);
-		GetGlobalColor(_T("DASHR"), &cl);
-		pen.SetColour(cl);
-		dc->SetPen(pen);
-		double angle1 = deg2rad(168); // 135 + 1/8 of270
-		double angle2 = deg2rad(135); // 90 + 45
-		int radi = m_radius - 1 - penwidth;
-		wxCoord x1 = m_cx + ((radi)* cos(angle1));
-		wxCoord y1 = m_cy + ((radi)* sin(angle1));
-		wxCoord x2 = m_cx + ((radi)* cos(angle2));
-		wxCoord y2 = m_cy + ((radi)* sin(angle2));
-		dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-
-		// Some platforms have trouble with transparent pen.
-		// so we simply draw arcs for the outer ring.
-		GetGlobalColor(_T("DASHF"), &cl);
-		pen.SetWidth(penwidth);
-		pen.SetColour(cl);
-		dc->SetPen(pen);
-		angle1 = deg2rad(0);
-		angle2 = deg2rad(180);
-		radi = m_radius - 1;
-
-		x1 = m_cx + ((radi)* cos(angle1));
-		y1 = m_cy + ((radi)* sin(angle1));
-		x2 = m_cx + ((radi)* cos(angle2));
-		y2 = m_cy + ((radi)* sin(angle2));
-		dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-		dc->DrawArc(x2, y2, x1, y1, m_cx, m_cy);
-
-	}
-	else if (m_MarkerOption == DIAL_MARKER_WARNING_HIGH) {
-		pen.SetWidth(penwidth * 2);
-		GetGlobalColor(_T("DASHR"), &cl);
-		pen.SetColour(cl);
-		dc->SetPen(pen);
-		double angle1 = deg2rad(45); // 45
-		double angle2 = deg2rad(12); // 45 - 1/8 of 270
-		int radi = m_radius - 1 - penwidth;
-		wxCoord x1 = m_cx + ((radi)* cos(angle1));
-		wxCoord y1 = m_cy + ((radi)* sin(angle1));
-		wxCoord x2 = m_cx + ((radi)* cos(angle2));
-		wxCoord y2 = m_cy + ((radi)* sin(angle2));
-		dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-
-		// Some platforms have trouble with transparent pen.
-		// so we simply draw arcs for the outer ring.
-		GetGlobalColor(_T("DASHF"), &cl);
-		pen.SetWidth(penwidth);
-		pen.SetColour(cl);
-		dc->SetPen(pen);
-		angle1 = deg2rad(0);
-		angle2 = deg2rad(180);
-		radi = m_radius - 1;
-
-		x1 = m_cx + ((radi)* cos(angle1));
-		y1 = m_cy + ((radi)* sin(angle1));
-		x2 = m_cx + ((radi)* cos(angle2));
-		y2 = m_cy + ((radi)* sin(angle2));
-		dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-		dc->DrawArc(x2, y2, x1, y1, m_cx, m_cy);
-
-	}
-	//  For battery status
-	else if (m_MarkerOption == DIAL_MARKER_GREEN_MID) {
-		pen.SetWidth(penwidth * 2);
-		GetGlobalColor(_T("DASHG"), &cl);
-		pen.SetColour(cl);
-		dc->SetPen(pen);
-		double angle1 = deg2rad(330); // 270 + 1/4 of 270
-		double angle2 = deg2rad(270);  
-		int radi = m_radius - 1 - penwidth;
-		wxCoord x1 = m_cx + ((radi)* cos(angle1));
-		wxCoord y1 = m_cy + ((radi)* sin(angle1));
-		wxCoord x2 = m_cx + ((radi)* cos(angle2));
-		wxCoord y2 = m_cy + ((radi)* sin(angle2));
-		dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-
-		// Some platforms have trouble with transparent pen.
-		// so we simply draw arcs for the outer ring.
-		GetGlobalColor(_T("DASHF"), &cl);
-		pen.SetWidth(penwidth);
-		pen.SetColour(cl);
-		dc->SetPen(pen);
-		angle1 = deg2rad(0);
-		angle2 = deg2rad(180);
-		radi = m_radius - 1;
-
-		x1 = m_cx + ((radi)* cos(angle1));
-		y1 = m_cy + ((radi)* sin(angle1));
-		x2 = m_cx + ((radi)* cos(angle2));
-		y2 = m_cy + ((radi)* sin(angle2));
-		dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-		dc->DrawArc(x2, y2, x1, y1, m_cx, m_cy);
-
-	}
-    
-    else if (m_MarkerOption == DIAL_MARKER_REDGREENBAR) {
-        pen.SetWidth(penwidth * 2);
-        GetGlobalColor(_T("DASHR"), &cl);
-        pen.SetColour(cl);
-        dc->SetPen(pen);
-        double angle1 = deg2rad(270); // 305-ANGLE_OFFSET
-        double angle2 = deg2rad(90); // 55-ANGLE_OFFSET
-        int radi = m_radius - 1 - penwidth;
-        wxCoord x1 = m_cx + ((radi) * cos(angle1));
-        wxCoord y1 = m_cy + ((radi) * sin(angle1));
-        wxCoord x2 = m_cx + ((radi) * cos(angle2));
-        wxCoord y2 = m_cy + ((radi) * sin(angle2));
-        dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-        
-        GetGlobalColor(_T("DASHG"), &cl);
-        pen.SetColour(cl);
-        dc->SetPen(pen);
-        angle1 = deg2rad(89); // 305-ANGLE_OFFSET
-        angle2 = deg2rad(271); // 55-ANGLE_OFFSET
-        x1 = m_cx + ((radi) * cos(angle1));
-        y1 = m_cy + ((radi) * sin(angle1));
-        x2 = m_cx + ((radi) * cos(angle2));
-        y2 = m_cy + ((radi) * sin(angle2));
-        dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-
-        // Some platforms have trouble with transparent pen.
-        // so we simply draw arcs for the outer ring.
-        GetGlobalColor(_T("DASHF"), &cl);
-        pen.SetWidth(penwidth);
-        pen.SetColour(cl);
-        dc->SetPen(pen);
-        angle1 = deg2rad(0); 
-        angle2 = deg2rad(180);
-        radi = m_radius - 1;
-        
-        x1 = m_cx + ((radi) * cos(angle1));
-        y1 = m_cy + ((radi) * sin(angle1));
-        x2 = m_cx + ((radi) * cos(angle2));
-        y2 = m_cy + ((radi) * sin(angle2));
-        dc->DrawArc(x1, y1, x2, y2, m_cx, m_cy);
-        dc->DrawArc(x2, y2, x1, y1, m_cx, m_cy);
-        
+    if (!(m_arcKey == GetGeometryKey())) {
+        UpdateArcs();
     }
-    else {
-        GetGlobalColor(_T("DASHF"), &cl);
+
+    if (m_arcs.empty()) {
+        cl = g_Palette.foreground;
         pen.SetColour(cl);
         dc->SetPen(pen);
         dc->DrawCircle(m_cx, m_cy, m_radius);
+        return;
+    }
+
+    for (size_t i = 0; i < m_arcs.size(); i++) {
+        const DialArc &arc = m_arcs[i];
+        switch (arc.colour) {
+            case DIAL_ARC_RED:
+                pen.SetWidth(penwidth * 2);
+                pen.SetColour(g_Palette.red);
+                break;
+            case DIAL_ARC_GREEN:
+                pen.SetWidth(penwidth * 2);
+                pen.SetColour(g_Palette.green);
+                break;
+            default:
+                pen.SetWidth(penwidth);
+                pen.SetColour(g_Palette.foreground);
+                break;
+        }
+        dc->SetPen(pen);
+        dc->DrawArc(arc.start, arc.end, wxPoint(m_cx, m_cy));
     }
 }
 
@@ -409,168 +665,148 @@ void DashboardInstrument_Dial::DrawMarkers(wxGCDC* dc) {
     if (m_MarkerOption == DIAL_MARKER_NONE) return;
 
     wxColour cl;
-    GetGlobalColor(_T("DASHF"), &cl);
+    cl = g_Palette.foreground;
     int penwidth = GetClientSize().x / 100;
     wxPen pen(cl, penwidth, wxPENSTYLE_SOLID);
     dc->SetPen(pen);
 
-    int diff_angle = m_AngleStart + m_AngleRange - ANGLE_OFFSET;
-    // angle between markers
-    double abm = m_AngleRange * m_MarkerStep / (m_MainValueMax - m_MainValueMin);
-    // don't draw last value, it's already done as first
-    if (m_AngleRange == 360) diff_angle -= abm;
+    if (!(m_markerKey == GetGeometryKey())) {
+        UpdateMarkers();
+    }
 
-    int offset = 0;
-    for (double angle = m_AngleStart - ANGLE_OFFSET; angle <= diff_angle; angle += abm) {
+    bool minorTicks = GetRenderQuality() < QUALITY_NO_MINOR_TICKS;
+    for (size_t i = 0; i < m_markers.size(); i++) {
+        const DialMarker &marker = m_markers[i];
+        if (marker.minor && !minorTicks) {
+            continue;
+        }
         if (m_MarkerOption == DIAL_MARKER_REDGREEN) {
-            int a = int(angle + ANGLE_OFFSET) % 360;
+            int a = marker.angle;
             if (a > 180) {
-                GetGlobalColor(_T("DASHR"), &cl);
+                cl = g_Palette.red;
             }
             else if ((a > 0) && (a < 180)) {
-                GetGlobalColor(_T("DASHG"), &cl);
+                cl = g_Palette.green;
             }
             else {
-                GetGlobalColor(_T("DASHF"), &cl);
+                cl = g_Palette.foreground;
             }
             pen.SetColour(cl);
             dc->SetPen(pen);
         }
 
-        double size = 0.92;
-        if (offset % m_MarkerOffset) {
-            size = 0.96;
-        }
-        offset++;
-
-        dc->DrawLine(m_cx + ((m_radius-1) * size * cos(deg2rad(angle))),
-                m_cy + ((m_radius-1) * size * sin(deg2rad(angle))),
-                m_cx + ((m_radius-1) * cos(deg2rad(angle))),
-                m_cy + ((m_radius-1) * sin(deg2rad(angle))));
+        dc->DrawLine(marker.inner, marker.outer);
     }
     // We must reset pen color so following drawings are fine
     if (m_MarkerOption == DIAL_MARKER_REDGREEN) {
-        GetGlobalColor(_T("DASHF"), &cl);
+        cl = g_Palette.foreground;
         pen.SetStyle(wxPENSTYLE_SOLID);
         pen.SetColour(cl);
         dc->SetPen(pen);
     }
 }
 
+// Render each label once per font, colour scheme and content scale. Labels are drawn before the frame
+// and markers, so the sprites have an opaque background. The corners of a rotated label's bounding box
+// overlap its neighbours, so its background is masked. Plain DC text rendering is used,
+// as Windows GCDC does a terrible job of rendering small texts.
+void DashboardInstrument_Dial::UpdateLabelSprites(wxGCDC* dc) {
+      m_spritesValid = true;
+      m_spriteScheme = g_ColorScheme;
+      m_spriteFont = *g_pFontSmall;
+      m_spriteScale = GetContentScale(this);
+      m_spriteLabelOption = GetLabelOption();
+
+      for (size_t i = 0; i < m_labels.size(); i++) {
+            DialLabel &label = m_labels[i];
+            dc->GetTextExtent(label.text, &label.width, &label.height, 0, 0, g_pFontSmall);
+
+            if (m_spriteLabelOption == DIAL_LABEL_ROTATED) {
+                  // Bounding box of the text rotated about its top-left corner
+                  double rotation = deg2rad(-90 - label.angle);
+                  double c = cos(rotation);
+                  double s = sin(rotation);
+                  double xs[4] = { 0, label.width * c, label.height * s, (label.width * c) + (label.height * s) };
+                  double ys[4] = { 0, -label.width * s, label.height * c, (-label.width * s) + (label.height * c) };
+                  double minX = xs[0], maxX = xs[0], minY = ys[0], maxY = ys[0];
+                  for (int j = 1; j < 4; j++) {
+                        minX = wxMin(minX, xs[j]);
+                        maxX = wxMax(maxX, xs[j]);
+                        minY = wxMin(minY, ys[j]);
+                        maxY = wxMax(maxY, ys[j]);
+                  }
+                  label.spriteOffset = wxPoint(floor(minX), floor(minY));
+                  CreateScaledBitmap(label.sprite, wxSize(ceil(maxX) - label.spriteOffset.x + 1, ceil(maxY) - label.spriteOffset.y + 1), m_spriteScale);
+            }
+            else {
+                  label.spriteOffset = wxPoint(0, 0);
+                  CreateScaledBitmap(label.sprite, wxSize(label.width, label.height), m_spriteScale);
+            }
+
+            wxMemoryDC mdc(label.sprite);
+            mdc.SetBackground(g_Palette.background);
+            mdc.Clear();
+            mdc.SetFont(*g_pFontSmall);
+            mdc.SetTextForeground(g_Palette.foreground);
+            if (m_spriteLabelOption == DIAL_LABEL_ROTATED) {
+                  mdc.DrawRotatedText(label.text, -label.spriteOffset.x, -label.spriteOffset.y, -90 - label.angle);
+            }
+            else {
+                  mdc.DrawText(label.text, 0, 0);
+            }
+            mdc.SelectObject(wxNullBitmap);
+            if (m_spriteLabelOption == DIAL_LABEL_ROTATED) {
+                  label.sprite.SetMask(new wxMask(label.sprite, g_Palette.background));
+            }
+      }
+}
+
+DialLabelOption DashboardInstrument_Dial::GetLabelOption(void) {
+      if ((m_LabelOption == DIAL_LABEL_ROTATED) && (GetRenderQuality() >= QUALITY_NO_ROTATED_LABELS)) {
+            return DIAL_LABEL_HORIZONTAL;
+      }
+      return m_LabelOption;
+}
+
 void DashboardInstrument_Dial::DrawLabels(wxGCDC* dc)
 {
       if (m_LabelOption == DIAL_LABEL_NONE)
             return;
 
-      wxPoint TextPoint;
-      wxPen pen;
-      wxColor cl;
-      GetGlobalColor(_T("DASHF"), &cl);
-
-#ifdef __WXMSW__
-      wxSize size = GetClientSize();
-      //        Create a new bitmap for this method graphics
-      wxBitmap tbm(size.x, size.y, -1);
-      wxMemoryDC tdc(tbm);
-
-      wxColour cback;
-      GetGlobalColor(_T("DASHB"), &cback);
-      tdc.SetBackground(cback);
-      tdc.Clear();
-      tdc.SetFont(*g_pFontSmall);
-      tdc.SetTextForeground(cl);
-
-#endif
+      if (!m_labelsValid) {
+            UpdateLabels();
+      }
 
-      dc->SetFont(*g_pFontSmall);
-      dc->SetTextForeground(cl);
+      if (!m_spritesValid || (m_spriteScheme != g_ColorScheme) || !(m_spriteFont == *g_pFontSmall) || (m_spriteScale != GetContentScale(this))
+            || (m_spriteLabelOption != GetLabelOption())) {
+            UpdateLabelSprites(dc);
+      }
 
-      int diff_angle = m_AngleStart + m_AngleRange - ANGLE_OFFSET;
-      // angle between markers
-      double abm = m_AngleRange * m_LabelStep / (m_MainValueMax - m_MainValueMin);
-      // don't draw last value, it's already done as first
-      if (m_AngleRange == 360) diff_angle -= abm;
+      wxPoint TextPoint;
 
-      int offset = 0;
-      int value = m_MainValueMin;
-      int width, height;
-	  wxString label;
-
-      for (double angle = m_AngleStart - ANGLE_OFFSET; angle <= diff_angle; angle += abm) {
-		  if (m_LabelOption == DIAL_LABEL_FRACTIONS) {
-			  if (value == 0) {
-				  label = "0";
-			  }
-			  if (value == 25) {
-				  label = "1/4";
-			  }
-			  if (value == 50) {
-				  label = "1/2";
-			  }
-			  if (value == 75) {
-				  label = "3/4";
-			  }
-			  if (value == 100) {
-				  label = "4/4";
-			  }
-		  }
-		  else {
-			  label = (m_LabelArray.GetCount() ? m_LabelArray.Item(offset) : wxString::Format(_T("%d"), value));
-		  }
-#ifdef __WXMSW__
-            if (g_pFontSmall->GetPointSize() <= 12)
-              tdc.GetTextExtent(label, &width, &height, 0, 0, g_pFontSmall);
-            else
-#endif
-              dc->GetTextExtent(label, &width, &height, 0, 0, g_pFontSmall);
+      for (size_t i = 0; i < m_labels.size(); i++) {
+            const DialLabel &label = m_labels[i];
 
-            double halfW = width / 2;
-            if ((m_LabelOption == DIAL_LABEL_HORIZONTAL) || (m_LabelOption == DIAL_LABEL_FRACTIONS))
+            double halfW = label.width / 2;
+            if ((m_spriteLabelOption == DIAL_LABEL_HORIZONTAL) || (m_spriteLabelOption == DIAL_LABEL_FRACTIONS))
             {
-                  double halfH = height / 2;
+                  double halfH = label.height / 2;
                   //double delta = sqrt(width*width+height*height);
                   double delta = sqrt(halfW*halfW+halfH*halfH);
-                  TextPoint.x = m_cx + ((m_radius * 0.90) - delta) * cos(deg2rad(angle)) - halfW;
-                  TextPoint.y = m_cy + ((m_radius * 0.90) - delta) * sin(deg2rad(angle)) - halfH;
-
-#ifdef __WXMSW__
-                  if (g_pFontSmall->GetPointSize() <= 12)
-                    tdc.DrawText(label, TextPoint);
-                  else
-#endif
-                    dc->DrawText(label, TextPoint);
-
-
+                  TextPoint.x = m_cx + ((m_radius * 0.90) - delta) * label.cosine - halfW;
+                  TextPoint.y = m_cy + ((m_radius * 0.90) - delta) * label.sine - halfH;
             }
-            else if (m_LabelOption == DIAL_LABEL_ROTATED)
+            else if (m_spriteLabelOption == DIAL_LABEL_ROTATED)
             {
-                  // The coordinates of dc->DrawRotatedText refer to the top-left corner
-                  // of the rectangle bounding the string. So we must calculate the
-                  // right coordinates depending of the angle.
+                  // The rotated text is positioned by the top-left corner of the rectangle
+                  // bounding the string. So we must calculate the right coordinates depending of the angle.
                   // Move left from the Marker so that the position is in the Middle of Text
-                  long double tmpangle = angle - rad2deg(asin(halfW / (0.90 * m_radius)));
+                  long double tmpangle = label.angle - rad2deg(asin(halfW / (0.90 * m_radius)));
                   TextPoint.x = m_cx + m_radius * 0.90 * cos(deg2rad(tmpangle));
                   TextPoint.y = m_cy + m_radius * 0.90 * sin(deg2rad(tmpangle));
-
-#ifdef __WXMSW__
-                 if (g_pFontSmall->GetPointSize() <= 12)
-                     tdc.DrawRotatedText(label, TextPoint, -90 - angle);
-                 else
-#endif
-                     dc->DrawRotatedText(label, TextPoint, -90 - angle);
-
             }
-            offset++;
-            value += m_LabelStep;
+            dc->DrawBitmap(label.sprite, TextPoint + label.spriteOffset, m_spriteLabelOption == DIAL_LABEL_ROTATED);
       }
-
-#ifdef __WXMSW__
-      tdc.SelectObject(wxNullBitmap);
-
-      if (g_pFontSmall->GetPointSize() <= 12)
-            dc->DrawBitmap(tbm, 0, 0, false);
-#endif
-
 }
 
 void DashboardInstrument_Dial::DrawBackground(wxGCDC* dc) {
@@ -579,41 +815,40 @@ void DashboardInstrument_Dial::DrawBackground(wxGCDC* dc) {
 }
 
 void DashboardInstrument_Dial::DrawData(wxGCDC* dc, double value,
-            wxString unit, wxString format, DialPositionOption position) {
+            const wxString &unit, ValueFormatter &formatter, DialPositionOption position) {
       if (position == DIAL_POSITION_NONE)
             return;
 
-      dc->SetFont(*g_pFontLabel);
       wxColour cl;
-      GetGlobalColor(_T("DASHF"), &cl);
-      dc->SetTextForeground(cl);
-
       wxSize size = GetClientSize();
+      GlyphAtlas &atlas = GetGlyphAtlas(*g_pFontLabel, g_Palette.foreground, g_Palette.background, GetContentScale(this));
 
-      wxString text;
-
-      if (!std::isnan(value)) {
+      static const wxString noData = _T("---");
 
+      if (!std::isnan(value) && !formatter.HasUnit(unit)) {
+          // The unit's suffix is only compiled when the unit changes
+          wxString suffix;
           if (unit == _T("\u00B0"))
-               text = wxString::Format(format, value)+DEGREE_SIGN;
+               suffix = DEGREE_SIGN;
           else if (unit == _T("\u00B0L")) // No special display for now, might be XX°< (as in text-only instrument)
-               text = wxString::Format(format, value)+DEGREE_SIGN;
+               suffix = DEGREE_SIGN;
           else if (unit == _T("\u00B0R")) // No special display for now, might be >XX°
-               text = wxString::Format(format, value)+DEGREE_SIGN;
+               suffix = DEGREE_SIGN;
           else if (unit == _T("\u00B0T"))
-               text = wxString::Format(format, value)+DEGREE_SIGN+_T("T");
+               suffix = DEGREE_SIGN+_T("T");
           else if (unit == _T("\u00B0M"))
-               text = wxString::Format(format, value)+DEGREE_SIGN+_T("M");
+               suffix = DEGREE_SIGN+_T("M");
           else if (unit == _T("N")) // Knots
-               text = wxString::Format(format, value)+_T(" Kts");
+               suffix = _T(" Kts");
           else
-               text = wxString::Format(format, value)+_T(" ")+unit;
+               suffix = _T(" ")+unit;
+          formatter.SetUnit(unit, wxEmptyString, suffix);
       }
-      else
-           text = _T("---");
+
+      const wxString &text = std::isnan(value) ? noData : formatter.Format(value);
 
       int width, height;
-      dc->GetMultiLineTextExtent(text, &width, &height, NULL, g_pFontLabel);
+      atlas.GetTextExtent(text, &width, &height);
 
       wxRect TextPoint;
       TextPoint.width = width;
@@ -627,11 +862,11 @@ void DashboardInstrument_Dial::DrawData(wxGCDC* dc, double value,
             {
                   TextPoint.x = m_cx - (width / 2) - 1;
                   TextPoint.y = (size.y * .75) - height;
-                  GetGlobalColor(_T("DASHL"), &cl);
+                  cl = g_Palette.title;
                   int penwidth = size.x / 100;
                   wxPen* pen = wxThePenList->FindOrCreatePen(cl, penwidth, wxPENSTYLE_SOLID);
                   dc->SetPen(*pen);
-                  GetGlobalColor(_T("DASHB"), &cl);
+                  cl = g_Palette.background;
                   dc->SetBrush(cl);
                   // There might be a background drawn below
                   // so we must clear it first.
@@ -656,54 +891,24 @@ void DashboardInstrument_Dial::DrawData(wxGCDC* dc, double value,
                   break;
       }
 
-     wxColour c2;
-     GetGlobalColor(_T("DASHB"), &c2);
-     wxColour c3;
-     GetGlobalColor(_T("DASHF"), &c3);
-
-     wxStringTokenizer tkz(text, _T("\n"));
-      wxString token;
-
-      token = tkz.GetNextToken();
-      while(token.Length()) {
-        dc->GetTextExtent(token, &width, &height, NULL, NULL, g_pFontLabel);
-
-#ifdef __WXMSW__
-        if (g_pFontLabel->GetPointSize() <= 12) {
-            wxBitmap tbm(width, height, -1);
-            wxMemoryDC tdc(tbm);
+      // Include the border drawn around the value inside the dial
+      m_dataRect.Union(wxRect(TextPoint).Inflate((size.x / 100) + 3));
 
-            tdc.SetBackground(c2);
-            tdc.Clear();
-            tdc.SetFont(*g_pFontLabel);
-            tdc.SetTextForeground(c3);
-
-            tdc.DrawText(token, 0, 0);
-            tdc.SelectObject(wxNullBitmap);
-
-            dc->DrawBitmap(tbm, TextPoint.x, TextPoint.y, false);
-         
-        }
-        else
-#endif
-            dc->DrawText(token, TextPoint.x, TextPoint.y);
-
-
-        TextPoint.y += height;
-        token = tkz.GetNextToken();
-      }
+      // Drawn from pre-rasterized glyphs, which are opaque on the background colour,
+      // as is the area behind the value
+      atlas.DrawText(dc, text, TextPoint.x, TextPoint.y);
 }
 
 void DashboardInstrument_Dial::DrawForeground(wxGCDC* dc) {
       // The default foreground is the arrow used in most dials
       wxColour cl;
-      GetGlobalColor(_T("DASH2"), &cl);
+      cl = g_Palette.hubOutline;
       wxPen pen1;
       pen1.SetStyle(wxPENSTYLE_SOLID);
       pen1.SetColour(cl);
       pen1.SetWidth(2);
       dc->SetPen(pen1);
-      GetGlobalColor(_T("DASH1"), &cl);
+      cl = g_Palette.hub;
       wxBrush brush1;
       brush1.SetStyle(wxBRUSHSTYLE_SOLID);
       brush1.SetColour(cl);
@@ -712,30 +917,36 @@ void DashboardInstrument_Dial::DrawForeground(wxGCDC* dc) {
 
       dc->SetPen(*wxTRANSPARENT_PEN);
 
-      GetGlobalColor(_T("DASHN"), &cl);
+      cl = g_Palette.needle;
       wxBrush brush;
       brush.SetStyle(wxBRUSHSTYLE_SOLID);
       brush.SetColour(cl);
       dc->SetBrush(brush);
 
+      wxPoint points[4];
+      GetNeedlePoints(points);
+      dc->DrawPolygon(4, points, 0, 0);
+}
+
+void DashboardInstrument_Dial::GetNeedlePoints(wxPoint points[4]) {
       /* this is fix for a +/-180° round instrument, when m_MainValue is supplied as <0..180><L | R>
        * for example TWA & AWA */
       double data;
 
       if (m_MainValueUnit == _T("\u00B0L"))
-          data=360-m_MainValue;
+          data=360-m_NeedleValue;
       else
-          data=m_MainValue;
+          data=m_NeedleValue;
 
-      // The arrow should stay inside fixed limits
+      // The arrow should stay inside fixed limits, and rests at the minimum without data
       double val;
-      if (data < m_MainValueMin) val = m_MainValueMin;
+      if (std::isnan(data)) val = m_MainValueMin;
+      else if (data < m_MainValueMin) val = m_MainValueMin;
       else if (data > m_MainValueMax) val = m_MainValueMax;
       else val = data;
 
       double value = deg2rad((val - m_MainValueMin) * m_AngleRange / (m_MainValueMax - m_MainValueMin)) + deg2rad(m_AngleStart - ANGLE_OFFSET);
 
-      wxPoint points[4];
       points[0].x = m_cx + (m_radius * 0.95 * cos(value - .010));
       points[0].y = m_cy + (m_radius * 0.95 * sin(value - .010));
       points[1].x = m_cx + (m_radius * 0.95 * cos(value + .015));
@@ -744,6 +955,5 @@ void DashboardInstrument_Dial::DrawForeground(wxGCDC* dc) {
       points[2].y = m_cy + (m_radius * 0.22 * sin(value + 2.8));
       points[3].x = m_cx + (m_radius * 0.22 * cos(value - 2.8));
       points[3].y = m_cy + (m_radius * 0.22 * sin(value - 2.8));
-      dc->DrawPolygon(4, points, 0, 0);
 }
 
@@ -0,0 +1,137 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Pre-rasterized glyphs, refer to glyph_atlas.h
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "glyph_atlas.h"
+#include "instrument.h"
+
+#include <list>
+
+GlyphAtlas::GlyphAtlas(const wxFont &font, const wxColour &foreground, const wxColour &background, double scale) {
+	m_font = font;
+	m_foreground = foreground;
+	m_background = background;
+	m_scale = scale;
+
+	int width;
+	wxScreenDC dc;
+	dc.GetTextExtent(_T("0"), &width, &m_lineHeight, 0, 0, &m_font);
+
+	wxString preset = GLYPH_ATLAS_PRESET;
+	for (wxString::const_iterator it = preset.begin(); it != preset.end(); ++it) {
+		GetGlyph((wxChar)(*it).GetValue());
+	}
+}
+
+bool GlyphAtlas::Matches(const wxFont &font, const wxColour &foreground, const wxColour &background, double scale) const {
+	return (m_font == font) && (m_foreground == foreground) && (m_background == background) && (m_scale == scale);
+}
+
+const Glyph &GlyphAtlas::GetGlyph(wxChar c) {
+	if ((c >= 0) && (c < GLYPH_ATLAS_TABLE_SIZE)) {
+		Glyph &glyph = m_table[c];
+		if (!glyph.bitmap.IsOk()) {
+			Rasterize(c, glyph);
+		}
+		return glyph;
+	}
+
+	std::map<wxChar, Glyph>::iterator it = m_others.find(c);
+	if (it == m_others.end()) {
+		it = m_others.insert(std::make_pair(c, Glyph())).first;
+		Rasterize(c, it->second);
+	}
+	return it->second;
+}
+
+// Plain DC text rendering is used, as Windows GCDC does a terrible job of rendering small texts
+void GlyphAtlas::Rasterize(wxChar c, Glyph &glyph) {
+	wxString text(c);
+	wxScreenDC sdc;
+	sdc.GetTextExtent(text, &glyph.width, &glyph.height, 0, 0, &m_font);
+
+	CreateScaledBitmap(glyph.bitmap, wxSize(glyph.width, glyph.height), m_scale);
+	wxMemoryDC mdc(glyph.bitmap);
+	mdc.SetBackground(m_background);
+	mdc.Clear();
+	mdc.SetFont(m_font);
+	mdc.SetTextForeground(m_foreground);
+	mdc.DrawText(text, 0, 0);
+	mdc.SelectObject(wxNullBitmap);
+}
+
+void GlyphAtlas::GetTextExtent(const wxString &text, int *width, int *height) {
+	int lineWidth = 0;
+	*width = 0;
+	*height = m_lineHeight;
+	for (wxString::const_iterator it = text.begin(); it != text.end(); ++it) {
+		wxChar c = (wxChar)(*it).GetValue();
+		if (c == '\n') {
+			lineWidth = 0;
+			*height += m_lineHeight;
+			continue;
+		}
+		lineWidth += GetGlyph(c).width;
+		*width = wxMax(*width, lineWidth);
+	}
+}
+
+void GlyphAtlas::DrawText(wxDC *dc, const wxString &text, int x, int y) {
+	int left = x;
+	for (wxString::const_iterator it = text.begin(); it != text.end(); ++it) {
+		wxChar c = (wxChar)(*it).GetValue();
+		if (c == '\n') {
+			x = left;
+			y += m_lineHeight;
+			continue;
+		}
+		const Glyph &glyph = GetGlyph(c);
+		if (glyph.width > 0) {
+			dc->DrawBitmap(glyph.bitmap, x, y, false);
+		}
+		x += glyph.width;
+	}
+}
+
+// Only accessed from the UI thread. A list, so that the atlases do not move as others are added.
+static std::list<GlyphAtlas> glyphAtlases;
+
+GlyphAtlas &GetGlyphAtlas(const wxFont &font, const wxColour &foreground, const wxColour &background, double scale) {
+	for (std::list<GlyphAtlas>::iterator it = glyphAtlases.begin(); it != glyphAtlases.end(); ++it) {
+		if (it->Matches(font, foreground, background, scale)) {
+			return *it;
+		}
+	}
+
+	if (glyphAtlases.size() >= MAX_GLYPH_ATLASES) {
+		glyphAtlases.clear();
+	}
+	glyphAtlases.push_back(GlyphAtlas(font, foreground, background, scale));
+	return glyphAtlases.back();
+}
+
+void InvalidateGlyphAtlases(void) {
+	glyphAtlases.clear();
+}
@@ -43,10 +43,141 @@
   #include "wx/wx.h"
 #endif //precompiled headers
 #include <cmath>
+#include <map>
 
 #include "instrument.h"
+#include "glyph_atlas.h"
 //#include "wx28compat.h"
 
+DashboardPalette g_Palette;
+
+void UpdatePalette(void) {
+      GetGlobalColor(_T("DASHB"), &g_Palette.background);
+      GetGlobalColor(_T("DASHL"), &g_Palette.title);
+      GetGlobalColor(_T("DASHF"), &g_Palette.foreground);
+      GetGlobalColor(_T("DASHR"), &g_Palette.red);
+      GetGlobalColor(_T("DASHG"), &g_Palette.green);
+      GetGlobalColor(_T("DASHN"), &g_Palette.needle);
+      GetGlobalColor(_T("DASH1"), &g_Palette.hub);
+      GetGlobalColor(_T("DASH2"), &g_Palette.hubOutline);
+}
+
+static std::map<std::pair<const wxFont *, wxString>, wxSize> textExtentCache;
+
+void GetCachedTextExtent(const wxString &text, const wxFont *font, int *width, int *height) {
+      std::pair<const wxFont *, wxString> key(font, text);
+      std::map<std::pair<const wxFont *, wxString>, wxSize>::iterator it = textExtentCache.find(key);
+      if (it == textExtentCache.end()) {
+            wxScreenDC dc;
+            wxSize extent;
+            dc.GetTextExtent(text, &extent.x, &extent.y, 0, 0, font);
+            it = textExtentCache.insert(std::make_pair(key, extent)).first;
+      }
+      *width = it->second.x;
+      *height = it->second.y;
+}
+
+void InvalidateTextExtentCache(void) {
+      textExtentCache.clear();
+}
+
+double GetContentScale(wxWindow *window) {
+#if wxCHECK_VERSION(3, 1, 6) && !defined(__WXMSW__)
+      return window->GetContentScaleFactor();
+#else
+      // Earlier versions do not draw scaled bitmaps at their logical size, and on Windows
+      // logical coordinates are already device pixels, so bitmaps are never scaled
+      return 1.0;
+#endif
+}
+
+// The bitmap's logical size is the given size, its pixels are the size multiplied by the scale
+void CreateScaledBitmap(wxBitmap &bitmap, wxSize size, double scale) {
+      bitmap.CreateScaled(wxMax(size.x, 1), wxMax(size.y, 1), wxBITMAP_SCREEN_DEPTH, scale);
+}
+
+// Compares the device pixels, as not every port records the scale factor of the bitmap
+bool IsScaledBitmapValid(const wxBitmap &bitmap, wxSize size, double scale) {
+      return bitmap.IsOk() && (bitmap.GetWidth() == wxRound(wxMax(size.x, 1) * scale))
+            && (bitmap.GetHeight() == wxRound(wxMax(size.y, 1) * scale));
+}
+
+static RenderQuality renderQuality = QUALITY_FULL;
+static double paintTime = 0;
+
+RenderQuality GetRenderQuality(void) {
+      return renderQuality;
+}
+
+void SetRenderQuality(RenderQuality quality) {
+      renderQuality = quality;
+}
+
+wxString GetRenderQualityName(RenderQuality quality) {
+      switch (quality) {
+            case QUALITY_FULL:
+                  return _T("Full");
+            case QUALITY_NO_ANTIALIAS:
+                  return _T("No Antialiasing");
+            case QUALITY_NO_MINOR_TICKS:
+                  return _T("No Minor Ticks");
+            case QUALITY_NO_ROTATED_LABELS:
+                  return _T("No Rotated Labels");
+            case QUALITY_REDUCED_RATE:
+                  return _T("Reduced Rate");
+            default:
+                  return wxEmptyString;
+      }
+}
+
+int GetAnimationInterval(void) {
+      return (renderQuality >= QUALITY_REDUCED_RATE) ? ANIMATION_INTERVAL * REDUCED_RATE_FACTOR : ANIMATION_INTERVAL;
+}
+
+void AddPaintTime(double time) {
+      paintTime += time;
+}
+
+double TakePaintTime(void) {
+      double time = paintTime;
+      paintTime = 0;
+      return time;
+}
+
+// Only accessed from the UI thread
+static int backBufferCount = 0;
+static unsigned long backBufferMemory = 0;
+
+// Assumes 32 bits per device pixel, whatever the platform actually uses
+static unsigned long GetBitmapMemory(const wxBitmap &bitmap) {
+      return bitmap.IsOk() ? (unsigned long)bitmap.GetWidth() * bitmap.GetHeight() * 4 : 0;
+}
+
+void ResizeBackBuffer(wxBitmap &buffer, wxSize size, double scale) {
+      ReleaseBackBuffer(buffer);
+      CreateScaledBitmap(buffer, size, scale);
+      if (buffer.IsOk()) {
+            backBufferCount++;
+            backBufferMemory += GetBitmapMemory(buffer);
+      }
+}
+
+void ReleaseBackBuffer(wxBitmap &buffer) {
+      if (buffer.IsOk()) {
+            backBufferCount--;
+            backBufferMemory -= GetBitmapMemory(buffer);
+      }
+      buffer = wxNullBitmap;
+}
+
+int GetBackBufferCount(void) {
+      return backBufferCount;
+}
+
+unsigned long GetBackBufferMemory(void) {
+      return backBufferMemory;
+}
+
 //----------------------------------------------------------------
 //
 //    Generic DashboardInstrument Implementation
@@ -60,9 +191,20 @@ DashboardInstrument::DashboardInstrument(wxWindow *pparent, wxWindowID id, wxStr
 
       SetBackgroundStyle(wxBG_STYLE_CUSTOM);
       SetDrawSoloInPane(false);
-      wxClientDC dc(this);
+      m_composited = false;
+
+      m_dirty = true;
+      m_refreshPending = false;
+      m_updateInterval = MAX_REFRESH_INTERVAL;
+      m_paintCost = 0;
+      m_lastDataTime = 0;
+      m_lastPaintTime = 0;
+      m_paintCount = 0;
+      m_ratePaintCount = 0;
+      m_rateTime = wxGetLocalTimeMillis();
+      m_channelCount = 0;
       int width;
-      dc.GetTextExtent(m_title, &width, &m_TitleHeight, 0, 0, g_pFontTitle);
+      GetCachedTextExtent(m_title, g_pFontTitle, &width, &m_TitleHeight);
 
       Connect(wxEVT_ERASE_BACKGROUND, wxEraseEventHandler(DashboardInstrument::OnEraseBackground));
       Connect(wxEVT_PAINT, wxPaintEventHandler(DashboardInstrument::OnPaint));
@@ -80,6 +222,10 @@ DashboardInstrument::DashboardInstrument(wxWindow *pparent, wxWindowID id, wxStr
 #endif      
 }
 
+DashboardInstrument::~DashboardInstrument() {
+      ReleaseBackBuffer(m_backBuffer);
+}
+
 void DashboardInstrument::MouseEvent(wxMouseEvent &event) {
     if (event.GetEventType() == wxEVT_RIGHT_DOWN) {
 		wxContextMenuEvent evtCtx(wxEVT_CONTEXT_MENU, this->GetId(), this->ClientToScreen(event.GetPosition()));
@@ -101,10 +247,13 @@ void DashboardInstrument::OnEraseBackground(wxEraseEvent& WXUNUSED(evt)) {
 }
 
 
+// The back-buffer persists between paints, so only the damaged area, see GetDamageRect,
+// is rendered into it and copied to the window
 void DashboardInstrument::OnPaint(wxPaintEvent& WXUNUSED(event)) {
-    wxAutoBufferedPaintDC pdc(this);
+    wxStopWatch frameTimer;
+    wxPaintDC pdc(this);
     if (!pdc.IsOk()) {
-        wxLogMessage(_T("DashboardInstrument::OnPaint() fatal: wxAutoBufferedPaintDC.IsOk() false."));
+        wxLogMessage(_T("DashboardInstrument::OnPaint() fatal: wxPaintDC.IsOk() false."));
         return;
     }
 
@@ -114,14 +263,47 @@ void DashboardInstrument::OnPaint(wxPaintEvent& WXUNUSED(event)) {
         return;
     }
 
-#if wxUSE_GRAPHICS_CONTEXT
-    wxGCDC dc(pdc);
-#else
-    wxDC &dc(pdc);
-#endif
+    wxRect update = GetUpdateRegion().GetBox();
+    if (update.IsEmpty()) {
+        update = GetClientRect();
+    }
+
+    // A new back-buffer has nothing in it, so must be rendered in full
+    wxRect render = update;
+    double scale = GetContentScale(this);
+    if (!IsScaledBitmapValid(m_backBuffer, size, scale)) {
+        ResizeBackBuffer(m_backBuffer, size, scale);
+        render = GetClientRect();
+    }
+
+    wxMemoryDC mdc(m_backBuffer);
+    {
+        wxGCDC dc(mdc);
+        Paint(dc, mdc, render);
+    }
+    pdc.Blit(update.x, update.y, update.width, update.height, &mdc, update.x, update.y);
+    mdc.SelectObject(wxNullBitmap);
+    AddPaintTime(frameTimer.TimeInMicro().ToDouble() / 1000.0);
+}
+
+void DashboardInstrument::Paint(wxGCDC &dc, wxDC &pdc, const wxRect &update) {
+    wxStopWatch paintTimer;
+    m_refreshPending = false;
+
+    wxSize size = GetClientSize();
+    if (size.x == 0 || size.y == 0) {
+        wxLogMessage(_T("DashboardInstrument::OnPaint() fatal: Zero size DC."));
+        return;
+    }
+
+    m_updateRect = update;
+    dc.SetClippingRegion(m_updateRect);
+    if ((GetRenderQuality() >= QUALITY_NO_ANTIALIAS) && dc.GetGraphicsContext()) {
+        dc.GetGraphicsContext()->SetAntialiasMode(wxANTIALIAS_NONE);
+    }
 
     wxColour cl;
-    GetGlobalColor(_T("DASHB"), &cl);
+    cl = g_Palette.background;
     dc.SetBackground(cl);
 #ifdef __WXGTK__
     dc.SetBrush(cl);
@@ -132,7 +314,7 @@ void DashboardInstrument::OnPaint(wxPaintEvent& WXUNUSED(event)) {
 
     Draw(&dc);
 
-    if (!m_drawSoloInPane) {
+    if (!m_drawSoloInPane && m_updateRect.Intersects(wxRect(0, 0, size.x, m_TitleHeight))) {
 
     //  Windows GCDC does a terrible job of rendering small texts
     //  Workaround by using plain old DC for title box if text size is too small
@@ -142,14 +324,14 @@ void DashboardInstrument::OnPaint(wxPaintEvent& WXUNUSED(event)) {
         {
             wxPen pen;
             pen.SetStyle(wxPENSTYLE_SOLID);
-            GetGlobalColor(_T("DASHL"), &cl);
+            cl = g_Palette.title;
             pen.SetColour(cl);
             dc.SetPen(pen);
             dc.SetBrush(cl);
             dc.DrawRoundedRectangle(0, 0, size.x, m_TitleHeight, 3);
 
             dc.SetFont(*g_pFontTitle);
-            GetGlobalColor(_T("DASHF"), &cl);
+            cl = g_Palette.foreground;
             dc.SetTextForeground(cl);
             dc.DrawText(m_title, 5, 0);
         }
@@ -157,25 +339,138 @@ void DashboardInstrument::OnPaint(wxPaintEvent& WXUNUSED(event)) {
 #ifdef __WXMSW__
         if (g_pFontTitle->GetPointSize() <= 12) {
             wxColour cl;
-            GetGlobalColor(_T("DASHB"), &cl);
+            cl = g_Palette.background;
             pdc.SetBrush(cl);
             pdc.DrawRectangle(0, 0, size.x, m_TitleHeight);
 
             wxPen pen;
             pen.SetStyle(wxPENSTYLE_SOLID);
-            GetGlobalColor(_T("DASHL"), &cl);
+            cl = g_Palette.title;
             pen.SetColour(cl);
             pdc.SetPen(pen);
             pdc.SetBrush(cl);
             pdc.DrawRoundedRectangle(0, 0, size.x, m_TitleHeight, 3);
 
             pdc.SetFont(*g_pFontTitle);
-            GetGlobalColor(_T("DASHF"), &cl);
+            cl = g_Palette.foreground;
             pdc.SetTextForeground(cl);
             pdc.DrawText(m_title, 5, 0);
         }
 #endif
     }
+
+    dc.DestroyClippingRegion();
+
+    // Record what has been painted, used by the refresh scheduler
+    m_dirty = false;
+    for (int i = 0; i < m_channelCount; i++) {
+        m_channels[i].painted = m_channels[i].latest;
+    }
+    m_lastPaintTime = wxGetLocalTimeMillis();
+    double elapsed = paintTimer.TimeInMicro().ToDouble() / 1000.0;
+    m_paintCost = (0.8 * m_paintCost) + (0.2 * elapsed);
+    m_paintCount++;
+}
+
+//----------------------------------------------------------------
+//
+//    Adaptive Refresh Scheduling
+//
+//----------------------------------------------------------------
+
+// Invoked by the dashboard window each time the instrument is sent a value
+void DashboardInstrument::NotifyDataUpdate(DASH_CAP st, double value) {
+    wxLongLong now = wxGetLocalTimeMillis();
+    if (m_lastDataTime > 0) {
+        m_updateInterval = (0.8 * m_updateInterval) + (0.2 * (now - m_lastDataTime).ToDouble());
+    }
+    m_lastDataTime = now;
+    m_dirty = true;
+
+    for (int i = 0; i < m_channelCount; i++) {
+        if (m_channels[i].cap == st) {
+            m_channels[i].latest = value;
+            return;
+        }
+    }
+
+    if (m_channelCount < MAX_REFRESH_CHANNELS) {
+        // First value for this capability, ensure it is considered to have moved
+        m_channels[m_channelCount].cap = st;
+        m_channels[m_channelCount].painted = nan("");
+        m_channels[m_channelCount].latest = value;
+        m_channelCount++;
+    }
+}
+
+// Refresh at the rate the data arrives if the value has moved noticeably,
+// otherwise defer the refresh to the maximum interval
+double DashboardInstrument::GetTargetInterval(void) {
+    double span = fabs(GetValueSpan());
+    if (span == 0) {
+        span = 1;
+    }
+
+    double movement = 0;
+    for (int i = 0; i < m_channelCount; i++) {
+        double painted = m_channels[i].painted;
+        double latest = m_channels[i].latest;
+        if (std::isnan(painted) || std::isnan(latest)) {
+            if (std::isnan(painted) != std::isnan(latest)) {
+                movement = 1;
+            }
+        }
+        else {
+            movement = wxMax(movement, fabs(latest - painted) / span);
+        }
+    }
+
+    if (movement < REFRESH_MOVEMENT_THRESHOLD) {
+        return MAX_REFRESH_INTERVAL;
+    }
+    double interval = wxMin(wxMax(m_updateInterval, (double)MIN_REFRESH_INTERVAL), (double)MAX_REFRESH_INTERVAL);
+    return (GetRenderQuality() >= QUALITY_REDUCED_RATE) ? wxMin(interval * REDUCED_RATE_FACTOR, (double)MAX_REFRESH_INTERVAL) : interval;
+}
+
+bool DashboardInstrument::IsRefreshDue(wxLongLong now) {
+    if (!m_dirty || m_refreshPending) {
+        return false;
+    }
+    if (!IsDisplayChanged()) {
+        m_dirty = false;
+        return false;
+    }
+    return (now - m_lastPaintTime).ToDouble() >= GetTargetInterval();
+}
+
+void DashboardInstrument::ScheduleRefresh(void) {
+    m_refreshPending = true;
+    RefreshDamage();
+}
+
+// A composited instrument has no window of its own to repaint, so the
+// damaged area of the dashboard window is invalidated instead
+void DashboardInstrument::RefreshDamage(void) {
+    wxRect rect = GetDamageRect();
+    if (m_composited) {
+        rect.Offset(GetPosition());
+        GetParent()->RefreshRect(rect, false);
+    }
+    else {
+        RefreshRect(rect, false);
+    }
+}
+
+// Paints per second since the previous call
+double DashboardInstrument::GetActualRate(wxLongLong now) {
+    double elapsed = (now - m_rateTime).ToDouble();
+    double rate = 0;
+    if (elapsed > 0) {
+        rate = (m_paintCount - m_ratePaintCount) * 1000.0 / elapsed;
+    }
+    m_ratePaintCount = m_paintCount;
+    m_rateTime = now;
+    return rate;
 }
 
 //----------------------------------------------------------------
@@ -186,16 +481,15 @@ void DashboardInstrument::OnPaint(wxPaintEvent& WXUNUSED(event)) {
 
 DashboardInstrument_Single::DashboardInstrument_Single(wxWindow *pparent, wxWindowID id, wxString title, DASH_CAP cap_flag, wxString format)
       :DashboardInstrument(pparent, id, title, cap_flag) {
-      m_format = format;
+      m_formatter.SetFormat(format);
       m_data = _T("---");
       m_DataHeight = 0;
 }
 
 wxSize DashboardInstrument_Single::GetSize(int orient, wxSize hint) {
-      wxClientDC dc(this);
       int w;
-      dc.GetTextExtent(m_title, &w, &m_TitleHeight, 0, 0, g_pFontTitle);
-      dc.GetTextExtent(_T("000"), &w, &m_DataHeight, 0, 0, g_pFontData);
+      GetCachedTextExtent(m_title, g_pFontTitle, &w, &m_TitleHeight);
+      GetCachedTextExtent(_T("000"), g_pFontData, &w, &m_DataHeight);
 
       if (orient == wxHORIZONTAL) {
           return wxSize(DefaultWidth, wxMax(hint.y, m_TitleHeight+m_DataHeight));
@@ -204,62 +498,54 @@ wxSize DashboardInstrument_Single::GetSize(int orient, wxSize hint) {
       }
 }
 
+// The value is drawn from pre-rasterized glyphs, which are rendered with a plain DC
+// as Windows GCDC does a terrible job of rendering small texts
 void DashboardInstrument_Single::Draw(wxGCDC* dc) {
-      wxColour cl;
-#ifdef __WXMSW__
-      wxBitmap tbm(dc->GetSize().x, m_DataHeight, -1);
-      wxMemoryDC tdc(tbm);
-      wxColour c2;
-      GetGlobalColor(_T("DASHB"), &c2);
-      tdc.SetBackground(c2);
-      tdc.Clear();
-
-      tdc.SetFont(*g_pFontData);
-      GetGlobalColor(_T("DASHF"), &cl);
-      tdc.SetTextForeground(cl);
-
-      tdc.DrawText(m_data, 10, 0);
-
-      tdc.SelectObject(wxNullBitmap);
-
-      dc->DrawBitmap(tbm, 0, m_TitleHeight, false);
-#else
-      dc->SetFont(*g_pFontData);
-      GetGlobalColor(_T("DASHF"), &cl);
-      dc->SetTextForeground(cl);
-
-      dc->DrawText(m_data, 10, m_TitleHeight);
-
-#endif
+      GlyphAtlas &atlas = GetGlyphAtlas(*g_pFontData, g_Palette.foreground, g_Palette.background, GetContentScale(this));
+      atlas.DrawText(dc, m_data, 10, m_TitleHeight);
+}
 
+// Only the value changes, the title is left alone
+wxRect DashboardInstrument_Single::GetDamageRect(void) {
+      wxSize size = GetClientSize();
+      return wxRect(0, m_TitleHeight, size.x, wxMax(size.y - m_TitleHeight, 0));
 }
 
 void DashboardInstrument_Single::SetData(DASH_CAP st, double data, wxString unit) {
       if (m_cap_flag.test(st)) {
             if (!std::isnan(data) && (data < 9999)) {
-                if (unit == _T("C"))
-                  m_data = wxString::Format(m_format, data)+DEGREE_SIGN+_T("C");
-                else if (unit == _T("\u00B0"))
-                  m_data = wxString::Format(m_format, data)+DEGREE_SIGN;
-                else if (unit == _T("\u00B0T"))
-                  m_data = wxString::Format(m_format, data)+DEGREE_SIGN+_(" true");
-                else if (unit == _T("\u00B0M"))
-                  m_data = wxString::Format(m_format, data)+DEGREE_SIGN+_(" mag");
-                else if (unit == _T("\u00B0L"))
-                  m_data = _T(">")+ wxString::Format(m_format, data)+DEGREE_SIGN;
-                else if (unit == _T("\u00B0R"))
-                  m_data = wxString::Format(m_format, data)+DEGREE_SIGN+_T("<");
-                else if (unit == _T("N")) //Knots
-                  m_data = wxString::Format(m_format, data)+_T(" Kts");
+                // The unit's prefix & suffix are only compiled when the unit changes
+                if (!m_formatter.HasUnit(unit)) {
+                  wxString prefix;
+                  wxString suffix;
+                  if (unit == _T("C"))
+                    suffix = DEGREE_SIGN+_T("C");
+                  else if (unit == _T("\u00B0"))
+                    suffix = DEGREE_SIGN;
+                  else if (unit == _T("\u00B0T"))
+                    suffix = DEGREE_SIGN+_(" true");
+                  else if (unit == _T("\u00B0M"))
+                    suffix = DEGREE_SIGN+_(" mag");
+                  else if (unit == _T("\u00B0L")) {
+                    prefix = _T(">");
+                    suffix = DEGREE_SIGN;
+                  }
+                  else if (unit == _T("\u00B0R"))
+                    suffix = DEGREE_SIGN+_T("<");
+                  else if (unit == _T("N")) //Knots
+                    suffix = _T(" Kts");
 /* maybe in the future ...
-                else if (unit == _T("M")) // m/s
-                  m_data = wxString::Format(m_format, data)+_T(" m/s");
-                else if (unit == _T("K")) // km/h
-                  m_data = wxString::Format(m_format, data)+_T(" km/h");
+                  else if (unit == _T("M")) // m/s
+                    suffix = _T(" m/s");
+                  else if (unit == _T("K")) // km/h
+                    suffix = _T(" km/h");
  ... to be completed
  */
-                else
-                  m_data = wxString::Format(m_format, data)+_T(" ")+unit;
+                  else
+                    suffix = _T(" ")+unit;
+                  m_formatter.SetUnit(unit, prefix, suffix);
+                }
+                m_formatter.Format(data, m_data);
             }
             else
                 m_data = _T("---");
@@ -268,27 +554,28 @@ void DashboardInstrument_Single::SetData(DASH_CAP st, double data, wxString unit
 
 // Dashboard Gauge
 // Gauge Display, Note it's height is the same as the title, and poitioned below the title
-// Not used as something weird occurring on Windows, not being sized or displayed correctly. WTF ??
+// The bar is drawn by the instrument itself, rather than using a wxGauge control which
+// was not sized or displayed correctly on Windows.
 DashboardInstrument_Gauge::DashboardInstrument_Gauge(wxWindow *pparent, wxWindowID id, wxString title, DASH_CAP cap_flag)
 	:DashboardInstrument(pparent, id, title, cap_flag)
 {
 	int w;
-	wxClientDC dc(this);
-	dc.GetTextExtent(m_title, &w, &m_TitleHeight, 0, 0, g_pFontTitle);
+	GetCachedTextExtent(m_title, g_pFontTitle, &w, &m_TitleHeight);
 
-	gauge = new wxGauge(this, wxID_ANY, 100, wxPoint(0, m_TitleHeight), 
-		wxSize(DefaultWidth, m_TitleHeight));
+	m_percent = -1;
+	m_paintedPercent = -1;
+	m_lowThreshold = -1;
+	m_highThreshold = 100;
+	m_formatter.SetFormat(_T("%d%%"));
 }
 
 DashboardInstrument_Gauge::~DashboardInstrument_Gauge(void) {
-	delete gauge;
 }
 
 wxSize DashboardInstrument_Gauge::GetSize(int orient, wxSize hint)
 {
-	wxClientDC dc(this);
 	int w;
-	dc.GetTextExtent(m_title, &w, &m_TitleHeight, 0, 0, g_pFontTitle);
+	GetCachedTextExtent(m_title, g_pFontTitle, &w, &m_TitleHeight);
 
 	if (orient == wxHORIZONTAL) {
 		return wxSize(wxMax(w, DefaultWidth), 2 * m_TitleHeight);
@@ -299,34 +586,81 @@ wxSize DashboardInstrument_Gauge::GetSize(int orient, wxSize hint)
 }
 
 void DashboardInstrument_Gauge::Draw(wxGCDC* dc) {
-	wxSize size = dc->GetSize();
-	gauge->SetSize(size.GetWidth(), m_TitleHeight);
+	wxSize size = GetClientSize();
+	wxRect bar(2, m_TitleHeight + 2, size.x - 4, size.y - m_TitleHeight - 4);
+	m_paintedPercent = m_percent;
+	if ((bar.width <= 2) || (bar.height <= 2)) {
+		return;
+	}
+
+	wxColour cl;
+	cl = g_Palette.foreground;
+	dc->SetPen(*wxThePenList->FindOrCreatePen(cl, 1, wxPENSTYLE_SOLID));
+	dc->SetBrush(*wxTRANSPARENT_BRUSH);
+	dc->DrawRectangle(bar);
+
+	if (m_percent < 0) {
+		return;
+	}
+
+	if ((m_percent <= m_lowThreshold) || (m_percent > m_highThreshold)) {
+		cl = g_Palette.red;
+	}
+	else {
+		cl = g_Palette.green;
+	}
+	dc->SetPen(*wxTRANSPARENT_PEN);
+	dc->SetBrush(cl);
+	dc->DrawRectangle(bar.x + 1, bar.y + 1, (bar.width - 2) * m_percent / 100, bar.height - 2);
+
+	const wxString &text = m_formatter.Format(m_percent);
+	int width, height;
+	dc->GetTextExtent(text, &width, &height, NULL, NULL, g_pFontSmall);
+	dc->SetFont(*g_pFontSmall);
+	cl = g_Palette.foreground;
+	dc->SetTextForeground(cl);
+	dc->DrawText(text, bar.x + ((bar.width - width) / 2), bar.y + ((bar.height - height) / 2));
+}
+
+// Only the bar changes, the title is left alone
+wxRect DashboardInstrument_Gauge::GetDamageRect(void) {
+	wxSize size = GetClientSize();
+	return wxRect(0, m_TitleHeight, size.x, wxMax(size.y - m_TitleHeight, 0));
 }
 
+// Values are displayed as a whole percentage, so a value that rounds to the
+// percentage already displayed does not cause a repaint, see IsDisplayChanged
 void DashboardInstrument_Gauge::SetData(DASH_CAP st, double data, wxString unit) {
 	if (m_cap_flag.test(st)) {
-		if (!std::isnan(data) && (data < 100)) { // Shouldn't have values greater than 100 %
-			gauge->SetValue((int)data);
+		if (std::isnan(data)) {
+			m_percent = -1;
+		}
+		else if (data <= 100) { // Shouldn't have values greater than 100 %
+			m_percent = wxMax(wxRound(data), 0);
 		}
 	}
 }
 
 
 
-// Simple Gauge using Unicode Block characters
+// Simple Gauge, originally drawn using Unicode Block characters, now drawn as a row of
+// rectangles, the last of which is partially filled
 DashboardInstrument_Block::DashboardInstrument_Block(wxWindow *pparent, wxWindowID id, wxString title, DASH_CAP cap_flag, wxString format)
 	:DashboardInstrument(pparent, id, title, cap_flag) {
 	m_format = format;
-	m_data = _T("---");
 	m_DataHeight = 0;
+	m_Value = -1;
+	m_paintedValue = -1;
+	m_formatter.SetFormat(_T(" (%d%%)"));
+	m_geometryDataHeight = 0;
+	m_textX = 0;
 
 }
 
 wxSize DashboardInstrument_Block::GetSize(int orient, wxSize hint) {
-	wxClientDC dc(this);
 	int w;
-	dc.GetTextExtent(m_title, &w, &m_TitleHeight, 0, 0, g_pFontTitle);
-	dc.GetTextExtent(_T("000000000000000"), &w, &m_DataHeight, 0, 0, g_pFontData);
+	GetCachedTextExtent(m_title, g_pFontTitle, &w, &m_TitleHeight);
+	GetCachedTextExtent(_T("000000000000000"), g_pFontData, &w, &m_DataHeight);
 
 	if (orient == wxHORIZONTAL) {
 		return wxSize(wxMax(w, DefaultWidth), m_TitleHeight + m_DataHeight);
@@ -336,45 +670,71 @@ wxSize DashboardInstrument_Block::GetSize(int orient, wxSize hint) {
 	}
 }
 
-void DashboardInstrument_Block::Draw(wxGCDC* dc) {
-	wxColour cl;
-#ifdef __WXMSW__
-	wxBitmap tbm(dc->GetSize().x, m_DataHeight, -1);
-	wxMemoryDC tdc(tbm);
-	wxColour c2;
-	GetGlobalColor(_T("DASHB"), &c2);
-	tdc.SetBackground(c2);
-	tdc.Clear();
-
-	tdc.SetFont(*g_pFontData);
-	if (m_Value > 20) {
-		GetGlobalColor(_T("DASHF"), &cl);
-	}
-	else {
-		GetGlobalColor(_T("DASHR"), &cl);
+// The cells occupy the space not needed by the percentage, and are as tall as a block character
+void DashboardInstrument_Block::UpdateGeometry(wxSize size) {
+	if ((size == m_geometrySize) && (m_DataHeight == m_geometryDataHeight)) {
+		return;
 	}
-	tdc.SetTextForeground(cl);
+	m_geometrySize = size;
+	m_geometryDataHeight = m_DataHeight;
 
-	tdc.DrawText(m_data, 0, 0);
+	int textWidth, textHeight;
+	GetCachedTextExtent(_T(" (100%)"), g_pFontData, &textWidth, &textHeight);
 
-	tdc.SelectObject(wxNullBitmap);
+	int left = 10;
+	int pitch = wxMax((size.x - left - textWidth) / BLOCK_CELLS, 2);
+	int top = m_TitleHeight + (m_DataHeight / 8);
+	int height = wxMax(m_DataHeight * 3 / 4, 1);
 
-	dc->DrawBitmap(tbm, 0, m_TitleHeight, false);
-#else
-	dc->SetFont(*g_pFontData);
+	m_cells.clear();
+	for (int i = 0; i < BLOCK_CELLS; i++) {
+		m_cells.push_back(wxRect(left + (i * pitch), top, pitch - 1, height));
+	}
+	m_textX = left + (BLOCK_CELLS * pitch);
+}
+
+void DashboardInstrument_Block::Draw(wxGCDC* dc) {
+	UpdateGeometry(GetClientSize());
+	m_paintedValue = m_Value;
 
+	wxColour cl;
 	if (m_Value > 20) {
-		GetGlobalColor(_T("DASHF"), &cl);
+		cl = g_Palette.foreground;
 	}
 	else {
-		GetGlobalColor(_T("DASHR"), &cl);
+		cl = g_Palette.red;
 	}
+	dc->SetFont(*g_pFontData);
 	dc->SetTextForeground(cl);
 
-	dc->DrawText(m_data, 10, m_TitleHeight);
+	if (m_Value < 0) {
+		dc->DrawText(_T("---"), 10, m_TitleHeight);
+		return;
+	}
 
-#endif
+	// Each cell represents 10%, the remainder is shown by partially filling the next cell
+	dc->SetPen(*wxTRANSPARENT_PEN);
+	dc->SetBrush(cl);
+	int full = wxMin(m_Value / 10, BLOCK_CELLS);
+	for (int i = 0; i < full; i++) {
+		dc->DrawRectangle(m_cells[i]);
+	}
+	int remainder = m_Value % 10;
+	if ((full < BLOCK_CELLS) && (remainder > 0)) {
+		wxRect partial = m_cells[full];
+		partial.width = partial.width * remainder / 10;
+		if (partial.width > 0) {
+			dc->DrawRectangle(partial);
+		}
+	}
+
+	dc->DrawText(m_formatter.Format(m_Value), m_textX, m_TitleHeight);
+}
 
+// Only the level changes, the title is left alone
+wxRect DashboardInstrument_Block::GetDamageRect(void) {
+	wxSize size = GetClientSize();
+	return wxRect(0, m_TitleHeight, size.x, wxMax(size.y - m_TitleHeight, 0));
 }
 
 void DashboardInstrument_Block::SetData(DASH_CAP st, double data, wxString unit) {
@@ -382,17 +742,10 @@ void DashboardInstrument_Block::SetData(DASH_CAP st, double data, wxString unit)
 		if (!std::isnan(data) && (data > 0) && (data <= 100)) {
 			if (unit == _T("Level")) {
 				m_Value = (int)data; // class member used to determine foreground colour
-				m_data.Clear();
-				for (int i = 0; i < (int)(data / 10); i++) {
-					m_data.Append(wxString::FromUTF8(u8"\u2588"));
-				}
-				if ((int)data < 90) {
-					m_data.Append(wxString::Format(" (%d%%)", (int)data));
-				}
 			}
 		}
 		else {
-			m_data = _T("---");
+			m_Value = -1;
 		}
 	}
 }
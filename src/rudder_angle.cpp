@@ -56,15 +56,15 @@ DashboardInstrument_RudderAngle::DashboardInstrument_RudderAngle( wxWindow *pare
       DashboardInstrument_Dial( parent, id, title, OCPN_DBP_STC_RSA, 100, 160, -40, +40) {
       // Default Rudder position is centered
       m_MainValue = 0;
+      m_NeedleValue = 0;
 }
 
 DashboardInstrument_RudderAngle::~DashboardInstrument_RudderAngle(void) {
 }
 
 wxSize DashboardInstrument_RudderAngle::GetSize(int orient, wxSize hint) {
-      wxClientDC dc(this);
       int w;
-      dc.GetTextExtent(m_title, &w, &m_TitleHeight, 0, 0, g_pFontTitle);
+      GetCachedTextExtent(m_title, g_pFontTitle, &w, &m_TitleHeight);
       if( orient == wxHORIZONTAL ) {
           w = wxMax(hint.y, (DefaultWidth-m_TitleHeight)/.7);
       } 
@@ -84,6 +84,7 @@ void DashboardInstrument_RudderAngle::SetData(DASH_CAP st, double data, wxString
             else if (data > m_MainValueMax) m_MainValue = m_MainValueMax;
             else m_MainValue = data;
             m_MainValueUnit = unit;
+            StartNeedle();
       }
       else if (st == m_ExtraValueCap) {
             m_ExtraValue = data;
@@ -107,7 +108,7 @@ void DashboardInstrument_RudderAngle::DrawFrame(wxGCDC* dc) {
       wxPen pen;
       pen.SetStyle(wxPENSTYLE_SOLID);
       pen.SetWidth(2);
-      GetGlobalColor(_T("DASHF"), &cl);
+      cl = g_Palette.foreground;
       pen.SetColour(cl);
       dc->SetPen(pen);
 
@@ -125,7 +126,7 @@ void DashboardInstrument_RudderAngle::DrawBackground(wxGCDC* dc) {
       wxCoord x = m_cx - (m_radius * 0.3);
       wxCoord y = m_cy - (m_radius * 0.5);
       wxColour cl;
-      GetGlobalColor(_T("DASH1"), &cl);
+      cl = g_Palette.hub;
       dc->SetBrush( cl );
       dc->DrawEllipticArc(x, y, m_radius * 0.6, m_radius * 1.4, 0, 180);
 }
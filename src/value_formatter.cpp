@@ -0,0 +1,269 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Precompiled value formatter, refer to value_formatter.h
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "value_formatter.h"
+
+#include <cmath>
+
+// Values at or above this magnitude are passed to wxString::Format, so that
+// the scaled value cannot overflow
+#define MAX_FIXED_VALUE 1e12
+
+ValueFormatter::ValueFormatter() {
+	m_unitValid = false;
+	m_compiled = false;
+	m_leftAlign = false;
+	m_zeroPad = false;
+	m_sign = 0;
+	m_width = 0;
+	m_precision = 0;
+	m_scale = 1;
+	m_head = 0;
+	m_prepared = false;
+}
+
+// Removes the escaped percent signs from the literal text, returns false if the text contains another conversion
+static bool UnescapeLiteral(const wxString &source, wxString *literal) {
+	literal->Clear();
+	for (size_t i = 0; i < source.length(); i++) {
+		if (source[i] == '%') {
+			if ((i + 1 < source.length()) && (source[i + 1] == '%')) {
+				i++;
+			}
+			else {
+				return false;
+			}
+		}
+		literal->Append(source[i]);
+	}
+	return true;
+}
+
+void ValueFormatter::SetFormat(const wxString &format) {
+	m_format = format;
+	m_compiled = false;
+	m_leftAlign = false;
+	m_zeroPad = false;
+	m_sign = 0;
+	m_width = 0;
+	m_precision = 0;
+
+	// Find the conversion, skipping any escaped percent signs
+	size_t start = 0;
+	while ((start = format.find('%', start)) != wxString::npos) {
+		if ((start + 1 < format.length()) && (format[start + 1] == '%')) {
+			start += 2;
+		}
+		else {
+			break;
+		}
+	}
+
+	if (start == wxString::npos) {
+		Prepare();
+		return;
+	}
+
+	size_t i = start + 1;
+	size_t length = format.length();
+
+	// Flags
+	for (; i < length; i++) {
+		wxUniChar c = format[i];
+		if (c == '-') {
+			m_leftAlign = true;
+		}
+		else if (c == '0') {
+			m_zeroPad = true;
+		}
+		else if (c == '+') {
+			m_sign = '+';
+		}
+		else if (c == ' ') {
+			if (m_sign == 0) {
+				m_sign = ' ';
+			}
+		}
+		else {
+			break;
+		}
+	}
+
+	// Width
+	for (; (i < length) && (format[i] >= '0') && (format[i] <= '9'); i++) {
+		m_width = (m_width * 10) + ((int)format[i].GetValue() - '0');
+	}
+
+	// Precision
+	int precision = -1;
+	if ((i < length) && (format[i] == '.')) {
+		precision = 0;
+		for (i++; (i < length) && (format[i] >= '0') && (format[i] <= '9'); i++) {
+			precision = (precision * 10) + ((int)format[i].GetValue() - '0');
+		}
+	}
+
+	// Length modifiers have no bearing on a double
+	while ((i < length) && ((format[i] == 'l') || (format[i] == 'L') || (format[i] == 'h'))) {
+		i++;
+	}
+
+	if (i >= length) {
+		Prepare();
+		return;
+	}
+
+	wxUniChar conversion = format[i];
+	if ((conversion == 'd') || (conversion == 'i')) {
+		// The value is rounded, the precision of an integer conversion is its minimum number of digits
+		m_precision = 0;
+	}
+	else if ((conversion == 'f') || (conversion == 'F')) {
+		m_precision = (precision < 0) ? 6 : precision;
+		if (m_precision > MAX_FORMAT_PRECISION) {
+			Prepare();
+			return;
+		}
+	}
+	else {
+		Prepare();
+		return;
+	}
+
+	if (!UnescapeLiteral(format.substr(0, start), &m_leading) || !UnescapeLiteral(format.substr(i + 1), &m_trailing)) {
+		Prepare();
+		return;
+	}
+
+	if (m_leftAlign) {
+		m_zeroPad = false;
+	}
+
+	m_scale = 1;
+	for (int j = 0; j < m_precision; j++) {
+		m_scale *= 10;
+	}
+
+	m_compiled = true;
+	Prepare();
+}
+
+void ValueFormatter::SetUnit(const wxString &unit, const wxString &prefix, const wxString &suffix) {
+	m_unit = unit;
+	m_unitValid = true;
+	m_prefix = prefix;
+	m_suffix = suffix;
+	Prepare();
+}
+
+// Copies the text that precedes the value into the buffer
+void ValueFormatter::Prepare(void) {
+	m_head = 0;
+	if (m_compiled) {
+		m_head = Append(m_head, m_prefix);
+		m_head = Append(m_head, m_leading);
+	}
+	m_prepared = true;
+}
+
+size_t ValueFormatter::Append(size_t position, const wxString &text) {
+	for (wxString::const_iterator it = text.begin(); (it != text.end()) && (position < MAX_FORMATTED_LENGTH); ++it) {
+		m_buffer[position++] = (wxChar)(*it).GetValue();
+	}
+	return position;
+}
+
+const wxChar *ValueFormatter::Format(double value, size_t *length) {
+	if (!m_compiled || std::isnan(value) || (std::fabs(value) >= MAX_FIXED_VALUE)) {
+		*length = Append(0, m_prefix + wxString::Format(m_format, value) + m_suffix);
+		m_prepared = false;
+		return m_buffer;
+	}
+
+	if (!m_prepared) {
+		Prepare();
+	}
+
+	bool negative = value < 0;
+	long long fixed = std::llround(std::fabs(value) * m_scale);
+	if (fixed == 0) {
+		negative = false;
+	}
+
+	// Digits are generated least significant first
+	wxChar digits[32];
+	int count = 0;
+	for (int i = 0; i < m_precision; i++) {
+		digits[count++] = (wxChar)('0' + (fixed % 10));
+		fixed /= 10;
+	}
+	if (m_precision > 0) {
+		digits[count++] = '.';
+	}
+	do {
+		digits[count++] = (wxChar)('0' + (fixed % 10));
+		fixed /= 10;
+	} while (fixed > 0);
+
+	wxChar sign = negative ? '-' : m_sign;
+	int padding = m_width - count - ((sign != 0) ? 1 : 0);
+
+	size_t position = m_head;
+	if (!m_leftAlign && !m_zeroPad) {
+		for (; (padding > 0) && (position < MAX_FORMATTED_LENGTH); padding--) {
+			m_buffer[position++] = ' ';
+		}
+	}
+	if ((sign != 0) && (position < MAX_FORMATTED_LENGTH)) {
+		m_buffer[position++] = sign;
+	}
+	if (m_zeroPad) {
+		for (; (padding > 0) && (position < MAX_FORMATTED_LENGTH); padding--) {
+			m_buffer[position++] = '0';
+		}
+	}
+	while ((count > 0) && (position < MAX_FORMATTED_LENGTH)) {
+		m_buffer[position++] = digits[--count];
+	}
+	for (; (padding > 0) && (position < MAX_FORMATTED_LENGTH); padding--) {
+		m_buffer[position++] = ' ';
+	}
+
+	position = Append(position, m_trailing);
+	*length = Append(position, m_suffix);
+	return m_buffer;
+}
+
+void ValueFormatter::Format(double value, wxString &text) {
+	size_t length;
+	const wxChar *buffer = Format(value, &length);
+	text.assign(buffer, length);
+}
+
+const wxString &ValueFormatter::Format(double value) {
+	Format(value, m_text);
+	return m_text;
+}
@@ -0,0 +1,362 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Allocation budget test. Replays recorded NMEA 0183, NMEA 2000 and SignalK payloads
+// through the decoders, the queues and the instruments as the plugin does, counting the
+// heap allocations made by each stage once warmed up. Exits non-zero if any stage exceeds
+// its budget of allocations per payload (or per paint), so that a regression fails the build.
+//
+// Usage: alloc_budget <replay file> <data folder>
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "ocpn_stubs.h"
+#include "alloc_counter.h"
+#include "decoder.h"
+#include "value_dispatch.h"
+#include "dial.h"
+#include "speedometer.h"
+#include "rudder_angle.h"
+
+#include <wx/filename.h>
+#include <wx/textfile.h>
+#include <wx/tokenzr.h>
+#include <algorithm>
+#include <cstdio>
+
+// Capacity of the test's queues, small so that the warm up reuses every slot
+#define REPLAY_QUEUE_SIZE 16
+// The payloads are replayed this many times to warm up the caches, then once more to be counted
+#define REPLAY_WARMUP_PASSES 4
+
+// Header of the Actisense format NMEA 2000 payloads received from OpenCPN, the data follows
+// it, refer to DashboardDecoder::DecodeN2K_127488
+#define N2K_HEADER_LENGTH 13
+
+typedef enum {
+	SOURCE_NMEA0183,
+	SOURCE_N2K,
+	SOURCE_SIGNALK,
+	SOURCE_COUNT
+} ReplaySource;
+
+static const char *sourceNames[SOURCE_COUNT] = { "NMEA 0183", "NMEA 2000", "SignalK" };
+
+// Allocations permitted per payload (per paint for the format stage), indexed by stage and source.
+// The NMEA 0183 parser tokenizes each sentence into strings, and the SignalK parser builds a
+// JSON tree of each delta, so they may allocate whilst parsing. Routing and dispatch reuse the
+// queue slots and the latest values, so must not allocate at all once warmed up.
+static const unsigned long allocationBudgets[ALLOC_STAGE_COUNT][SOURCE_COUNT] = {
+	{ 0, 0, 0 },     // None
+	{ 64, 8, 256 },  // Parse
+	{ 0, 0, 0 },     // Route
+	{ 0, 0, 0 },     // Dispatch
+	{ 8, 8, 8 }      // Format
+};
+
+struct ReplayItem {
+	ReplaySource source;
+	IngestType type;
+	wxString sentence;
+	std::vector<uint8_t> payload;
+};
+
+// Parses the replay file, each line being the type followed by its data:
+// XDR, RPM or RSA and the sentence, the PGN and the bytes (hex) of its data, or SK and the delta.
+static bool LoadReplay(const wxString &fileName, std::vector<ReplayItem> &items) {
+	wxTextFile file;
+	if (!file.Open(fileName)) {
+		fprintf(stderr, "Unable to open %s\n", (const char *)fileName.mb_str());
+		return false;
+	}
+
+	for (wxString line = file.GetFirstLine(); !file.Eof(); line = file.GetNextLine()) {
+		line.Trim(false).Trim(true);
+		if (line.IsEmpty() || line.StartsWith(_T("#"))) {
+			continue;
+		}
+
+		ReplayItem item;
+		wxString type = line.BeforeFirst(' ');
+		wxString data = line.AfterFirst(' ');
+		if ((type == _T("XDR")) || (type == _T("RPM")) || (type == _T("RSA"))) {
+			item.source = SOURCE_NMEA0183;
+			item.type = (type == _T("XDR")) ? INGEST_NMEA0183_XDR : (type == _T("RPM")) ? INGEST_NMEA0183_RPM : INGEST_NMEA0183_RSA;
+			// The decoders expect the sentence terminator
+			item.sentence = data + _T("\r\n");
+		}
+		else if (type == _T("SK")) {
+			item.source = SOURCE_SIGNALK;
+			item.type = INGEST_SIGNALK;
+			item.sentence = data;
+		}
+		else {
+			item.source = SOURCE_N2K;
+			if (type == _T("127488")) item.type = INGEST_N2K_127488;
+			else if (type == _T("127489")) item.type = INGEST_N2K_127489;
+			else if (type == _T("127505")) item.type = INGEST_N2K_127505;
+			else if (type == _T("127508")) item.type = INGEST_N2K_127508;
+			else if (type == _T("130312")) item.type = INGEST_N2K_130312;
+			else if (type == _T("127245")) item.type = INGEST_N2K_127245;
+			else {
+				fprintf(stderr, "Unknown payload type %s, line %zu\n", (const char *)type.mb_str(), file.GetCurrentLine() + 1);
+				return false;
+			}
+			item.payload.assign(N2K_HEADER_LENGTH, 0);
+			wxStringTokenizer tokens(data, _T(" "));
+			while (tokens.HasMoreTokens()) {
+				unsigned long byte;
+				tokens.GetNextToken().ToULong(&byte, 16);
+				item.payload.push_back((uint8_t)byte);
+			}
+		}
+		items.push_back(item);
+	}
+	return true;
+}
+
+// Routes and dispatches the decoded values with the plugin's functions, refer to value_dispatch.h,
+// dashboard_pi::SendBatchToAllInstruments and dashboard_pi::OnDecodedValues, but on a single thread.
+class ReplayListener : public DecoderListener {
+public:
+	ReplayListener(std::vector<DashboardInstrument *> &instruments) : m_instruments(instruments) {
+		// As the dashboard's instrument containers hold them
+		for (size_t i = 0; i < m_instruments.size(); i++) {
+			m_caps.push_back(m_instruments[i]->GetCapacity());
+		}
+	}
+
+	void SendSentenceToAllInstruments(DASH_CAP st, double value, wxString unit) {
+		AllocStageScope scope(ALLOC_STAGE_ROUTE);
+		QueueDecodedValue(m_decodedQueue, st, value, unit);
+	}
+
+	void SendBatchToAllInstruments(const DashboardBatch &batch) {
+		AllocStageScope scope(ALLOC_STAGE_ROUTE);
+		QueueDecodedValues(m_decodedQueue, batch.GetValues(), batch.GetCount());
+	}
+
+	void OnDualEngineDetected(void) {
+	}
+
+	// Returns whether any of the instruments received a value
+	bool DispatchDecodedValues(std::vector<bool> &updated) {
+		AllocStageScope scope(ALLOC_STAGE_DISPATCH);
+		bool result = false;
+		DecodedValue *decoded;
+		size_t count;
+		while ((count = m_decodedQueue.FrontSpan(&decoded)) > 0) {
+			m_latestValues.Store(decoded, count);
+			for (size_t i = 0; i < m_instruments.size(); i++) {
+				if (SendValuesToInstrument(m_instruments[i], m_caps[i], decoded, count)) {
+					updated[i] = true;
+					result = true;
+				}
+			}
+			m_decodedQueue.Pop(count);
+		}
+		return result;
+	}
+
+private:
+	std::vector<DashboardInstrument *> &m_instruments;
+	std::vector<CapType> m_caps;
+	SpscQueue<DecodedValue, REPLAY_QUEUE_SIZE * MAX_BATCH_VALUES> m_decodedQueue;
+	LatestValues m_latestValues;
+};
+
+class AllocBudgetApp : public wxApp {
+public:
+	bool OnInit(void);
+	int OnRun(void);
+
+private:
+	wxString m_replayFile;
+	wxString m_dataFolder;
+};
+
+wxIMPLEMENT_APP(AllocBudgetApp);
+
+bool AllocBudgetApp::OnInit(void) {
+	if (argc != 3) {
+		fprintf(stderr, "Usage: alloc_budget <replay file> <data folder>\n");
+		return false;
+	}
+	// Log to the console rather than to message boxes
+	delete wxLog::SetActiveTarget(new wxLogStderr());
+	m_replayFile = argv[1];
+	m_dataFolder = argv[2];
+	if (!m_dataFolder.EndsWith(wxFileName::GetPathSeparator())) {
+		m_dataFolder += wxFileName::GetPathSeparator();
+	}
+	return true;
+}
+
+int AllocBudgetApp::OnRun(void) {
+	std::vector<ReplayItem> items;
+	if (!LoadReplay(m_replayFile, items) || items.empty()) {
+		return 1;
+	}
+
+	InitializeStubs(m_dataFolder);
+
+	// The instruments are never shown, invalidations are passed to the hidden frame and ignored
+	wxFrame *host = new wxFrame(NULL, wxID_ANY, _T("Allocation Budget"));
+
+	// A dashboard of the instruments that display the replayed values, configured as the plugin does
+	std::vector<DashboardInstrument *> instruments;
+	DashboardInstrument_Dial *dial;
+	dial = new DashboardInstrument_Speedometer(host, wxID_ANY, _T("Tachometer"), OCPN_DBP_STC_MAIN_ENGINE_RPM, 0, 6000);
+	dial->SetOptionLabel(1000, DIAL_LABEL_HORIZONTAL);
+	dial->SetOptionMarker(200, DIAL_MARKER_SIMPLE, 1);
+	dial->SetOptionExtraValue(OCPN_DBP_STC_MAIN_ENGINE_HOURS, _T("%.1f"), DIAL_POSITION_INSIDE);
+	dial->SetOptionWarningValue(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE);
+	instruments.push_back(dial);
+	dial = new DashboardInstrument_Dial(host, wxID_ANY, _T("Temperature"), OCPN_DBP_STC_MAIN_ENGINE_WATER, 225, 270, 0, 120);
+	dial->SetOptionLabel(20, DIAL_LABEL_HORIZONTAL);
+	dial->SetOptionMarker(10, DIAL_MARKER_WARNING_HIGH, 1);
+	dial->SetOptionMainValue(_T("%.1f"), DIAL_POSITION_INSIDE);
+	instruments.push_back(dial);
+	dial = new DashboardInstrument_Dial(host, wxID_ANY, _T("Oil Pressure"), OCPN_DBP_STC_MAIN_ENGINE_OIL, 225, 270, 0, 5);
+	dial->SetOptionLabel(1, DIAL_LABEL_HORIZONTAL);
+	dial->SetOptionMarker(1, DIAL_MARKER_WARNING_LOW, 1);
+	dial->SetOptionMainValue(_T("%.1f"), DIAL_POSITION_INSIDE);
+	instruments.push_back(dial);
+	dial = new DashboardInstrument_RudderAngle(host, wxID_ANY, _T("Rudder Angle"));
+	dial->SetOptionMarker(5, DIAL_MARKER_REDGREEN, 2);
+	instruments.push_back(dial);
+	instruments.push_back(new DashboardInstrument_Single(host, wxID_ANY, _T("Alternator"), OCPN_DBP_STC_MAIN_ENGINE_VOLTS, _T("%.1f")));
+	instruments.push_back(new DashboardInstrument_Single(host, wxID_ANY, _T("Start Battery"), OCPN_DBP_STC_START_BATTERY_VOLTS, _T("%.1f")));
+	instruments.push_back(new DashboardInstrument_Block(host, wxID_ANY, _T("Fuel"), OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, _T("%s")));
+
+	std::vector<wxBitmap> frames;
+	for (size_t i = 0; i < instruments.size(); i++) {
+		DashboardInstrument_Dial *needle = dynamic_cast<DashboardInstrument_Dial *>(instruments[i]);
+		if (needle != NULL) {
+			// Needles are drawn at their value, rather than animating towards it
+			needle->SetOptionNeedleDamping(0);
+		}
+		instruments[i]->SetComposited(true);
+		wxSize size = instruments[i]->GetSize(wxVERTICAL, wxSize(DefaultWidth, 0));
+		instruments[i]->SetSize(size);
+		frames.push_back(wxBitmap(size.x, size.y));
+	}
+
+	ReplayListener listener(instruments);
+	DashboardDecoder decoder(&listener);
+	DecoderSettings settings = { TEMPERATURE_CELSIUS, PRESSURE_BAR, false };
+	decoder.PublishSettings(settings);
+
+	SpscQueue<IngestItem, REPLAY_QUEUE_SIZE> ingestQueue;
+	std::vector<bool> updated(instruments.size());
+
+	unsigned long baseline[ALLOC_STAGE_COUNT] = { 0 };
+	unsigned long allocations[ALLOC_STAGE_COUNT][SOURCE_COUNT] = { { 0 } };
+	unsigned long payloads[SOURCE_COUNT] = { 0 };
+	unsigned long paints[SOURCE_COUNT] = { 0 };
+
+	for (int pass = 0; pass <= REPLAY_WARMUP_PASSES; pass++) {
+		bool counted = (pass == REPLAY_WARMUP_PASSES);
+		for (size_t n = 0; n < items.size(); n++) {
+			const ReplayItem &replay = items[n];
+			for (int stage = 0; stage < ALLOC_STAGE_COUNT; stage++) {
+				baseline[stage] = GetAllocationCount((AllocStage)stage);
+			}
+
+			// Received by the UI thread, refer to dashboard_pi::Enqueue
+			{
+				AllocStageScope scope(ALLOC_STAGE_ROUTE);
+				IngestItem *item;
+				if (replay.source == SOURCE_N2K) {
+					item = ReserveIngestItem(ingestQueue, replay.type, replay.payload);
+				}
+				else {
+					item = ReserveIngestItem(ingestQueue, replay.type, replay.sentence);
+				}
+				if (item == NULL) {
+					continue;
+				}
+				ingestQueue.Push();
+			}
+
+			// Decoded by the decode thread, refer to dashboard_pi::DecodeIngestQueue
+			IngestItem *item;
+			while ((item = ingestQueue.Front()) != NULL) {
+				AllocStageScope scope(ALLOC_STAGE_PARSE);
+				decoder.DecodeItem(*item);
+				ingestQueue.Pop();
+			}
+
+			std::fill(updated.begin(), updated.end(), false);
+			listener.DispatchDecodedValues(updated);
+
+			// Each instrument that received a value is painted, as it would be when next refreshed
+			for (size_t i = 0; i < instruments.size(); i++) {
+				if (!updated[i]) {
+					continue;
+				}
+				wxMemoryDC mdc(frames[i]);
+				{
+					wxGCDC dc(mdc);
+					AllocStageScope scope(ALLOC_STAGE_FORMAT);
+					instruments[i]->Paint(dc, mdc, wxRect(frames[i].GetWidth(), frames[i].GetHeight()));
+				}
+				mdc.SelectObject(wxNullBitmap);
+				if (counted) {
+					paints[replay.source]++;
+				}
+			}
+
+			if (counted) {
+				payloads[replay.source]++;
+				for (int stage = 0; stage < ALLOC_STAGE_COUNT; stage++) {
+					allocations[stage][replay.source] += GetAllocationCount((AllocStage)stage) - baseline[stage];
+				}
+			}
+		}
+	}
+
+	int result = 0;
+	for (int source = 0; source < SOURCE_COUNT; source++) {
+		if (payloads[source] == 0) {
+			continue;
+		}
+		for (int stage = ALLOC_STAGE_PARSE; stage < ALLOC_STAGE_COUNT; stage++) {
+			unsigned long events = (stage == ALLOC_STAGE_FORMAT) ? paints[source] : payloads[source];
+			if (events == 0) {
+				continue;
+			}
+			double perEvent = (double)allocations[stage][source] / events;
+			bool exceeded = perEvent > allocationBudgets[stage][source];
+			printf("%-9s %-8s Allocations: %6lu, Events: %4lu, Per Event: %7.2f, Budget: %3lu%s\n",
+				sourceNames[source], GetAllocationStageName((AllocStage)stage), allocations[stage][source],
+				events, perEvent, allocationBudgets[stage][source], exceeded ? ", EXCEEDED" : "");
+			if (exceeded) {
+				result = 1;
+			}
+		}
+	}
+
+	host->Destroy();
+	ReleaseStubs();
+	return result;
+}
@@ -0,0 +1,95 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Heap allocation counting, refer to alloc_counter.h
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static thread_local AllocStage currentStage = ALLOC_STAGE_NONE;
+static std::atomic<unsigned long> allocationCount[ALLOC_STAGE_COUNT];
+
+AllocStageScope::AllocStageScope(AllocStage stage) {
+	m_previous = currentStage;
+	currentStage = stage;
+}
+
+AllocStageScope::~AllocStageScope() {
+	currentStage = m_previous;
+}
+
+const char *GetAllocationStageName(AllocStage stage) {
+	switch (stage) {
+		case ALLOC_STAGE_PARSE:
+			return "Parse";
+		case ALLOC_STAGE_ROUTE:
+			return "Route";
+		case ALLOC_STAGE_DISPATCH:
+			return "Dispatch";
+		case ALLOC_STAGE_FORMAT:
+			return "Format";
+		default:
+			return "None";
+	}
+}
+
+unsigned long GetAllocationCount(AllocStage stage) {
+	return allocationCount[stage].load(std::memory_order_relaxed);
+}
+
+static void *CountedAllocation(std::size_t size) {
+	allocationCount[currentStage].fetch_add(1, std::memory_order_relaxed);
+	void *p = std::malloc(size == 0 ? 1 : size);
+	if (p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void *operator new(std::size_t size) {
+	return CountedAllocation(size);
+}
+
+void *operator new[](std::size_t size) {
+	return CountedAllocation(size);
+}
+
+void operator delete(void *p) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+	std::free(p);
+}
@@ -0,0 +1,58 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Heap allocation counting for the allocation budget test. Replaces the global operator new
+// of the test executable, and counts each allocation against the stage of the decode and
+// display path that made it (parse, route, dispatch, format).
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _ALLOCCOUNTER_H_
+#define _ALLOCCOUNTER_H_
+
+typedef enum {
+	ALLOC_STAGE_NONE,
+	// Parsing a NMEA 0183 sentence, NMEA 2000 payload or SignalK message
+	ALLOC_STAGE_PARSE,
+	// Passing a message or its decoded values between the UI and decode threads
+	ALLOC_STAGE_ROUTE,
+	// Delivering decoded values to the instruments
+	ALLOC_STAGE_DISPATCH,
+	// Painting an instrument, including formatting its values
+	ALLOC_STAGE_FORMAT,
+	ALLOC_STAGE_COUNT
+} AllocStage;
+
+// Sets the stage for the current thread until the end of the enclosing scope
+class AllocStageScope {
+public:
+	AllocStageScope(AllocStage stage);
+	~AllocStageScope();
+
+private:
+	AllocStage m_previous;
+};
+
+extern const char *GetAllocationStageName(AllocStage stage);
+extern unsigned long GetAllocationCount(AllocStage stage);
+
+#endif // _ALLOCCOUNTER_H_
@@ -0,0 +1,134 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Needle animation test. Sends a dial a value, then no data (NaN, eg. a null SignalK value),
+// then values again, checking that the needle never animates to or from NaN and settles
+// on each value. Exits non-zero if it does not.
+//
+// Usage: dial_needle <data folder>
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "ocpn_stubs.h"
+#include "dial.h"
+
+#include <wx/filename.h>
+#include <cmath>
+#include <cstdio>
+
+// Animation frames allowed for the needle to settle, several times the damping period
+#define NEEDLE_SETTLE_FRAMES 100
+
+// Exposes the needle's position
+class NeedleTestDial : public DashboardInstrument_Dial {
+public:
+	NeedleTestDial(wxWindow *parent) : DashboardInstrument_Dial(parent, wxID_ANY, _T("Needle"), OCPN_DBP_STC_MAIN_ENGINE_RPM, 225, 270, 0, 100) {}
+	double GetNeedleValue(void) { return m_NeedleValue; }
+};
+
+// Steps the animation as the dashboard's timer does, returns the number of frames until the needle settled
+static int SettleNeedle(NeedleTestDial *dial, wxLongLong &now) {
+	for (int frame = 0; frame < NEEDLE_SETTLE_FRAMES; frame++) {
+		now += ANIMATION_INTERVAL;
+		if (!dial->Animate(now)) {
+			return frame;
+		}
+	}
+	return NEEDLE_SETTLE_FRAMES;
+}
+
+static bool Check(bool condition, const char *description) {
+	printf("%s: %s\n", condition ? "Passed" : "Failed", description);
+	return condition;
+}
+
+static bool RunNeedleTest(wxWindow *host) {
+	NeedleTestDial *dial = new NeedleTestDial(host);
+	dial->SetComposited(true);
+	dial->SetOptionNeedleDamping(0.4);
+	dial->SetSize(dial->GetSize(wxVERTICAL, wxSize(DefaultWidth, 0)));
+	wxLongLong now = wxGetLocalTimeMillis();
+	bool result = true;
+
+	dial->SetData(OCPN_DBP_STC_MAIN_ENGINE_RPM, 50, _T("RPM"));
+	result &= Check(dial->IsAnimating(), "A new value animates the needle");
+	now += ANIMATION_INTERVAL;
+	dial->Animate(now);
+
+	// No data whilst moving
+	dial->SetData(OCPN_DBP_STC_MAIN_ENGINE_RPM, NAN, _T("RPM"));
+	result &= Check(!dial->IsAnimating(), "No data stops the needle");
+	result &= Check(!dial->Animate(now + ANIMATION_INTERVAL), "No data does not animate");
+	wxRect damage = dial->GetDamageRect();
+	result &= Check(!damage.IsEmpty() && dial->GetClientRect().Contains(damage.GetTopLeft()), "No data places the needle on the dial");
+
+	// The first value after no data is shown immediately
+	dial->SetData(OCPN_DBP_STC_MAIN_ENGINE_RPM, 80, _T("RPM"));
+	result &= Check(!dial->IsAnimating() && (dial->GetNeedleValue() == 80), "A value after no data places the needle");
+
+	// Then values animate and settle again
+	dial->SetData(OCPN_DBP_STC_MAIN_ENGINE_RPM, 20, _T("RPM"));
+	result &= Check(dial->IsAnimating(), "A following value animates the needle");
+	result &= Check(SettleNeedle(dial, now) < NEEDLE_SETTLE_FRAMES, "The needle settles");
+	result &= Check(dial->GetNeedleValue() == 20, "The needle settles on the value");
+
+	dial->Destroy();
+	return result;
+}
+
+class DialNeedleApp : public wxApp {
+public:
+	bool OnInit(void);
+	int OnRun(void);
+
+private:
+	wxString m_dataFolder;
+};
+
+wxIMPLEMENT_APP(DialNeedleApp);
+
+bool DialNeedleApp::OnInit(void) {
+	if (argc != 2) {
+		fprintf(stderr, "Usage: dial_needle <data folder>\n");
+		return false;
+	}
+	// Log to the console rather than to message boxes
+	delete wxLog::SetActiveTarget(new wxLogStderr());
+	m_dataFolder = argv[1];
+	if (!m_dataFolder.EndsWith(wxFileName::GetPathSeparator())) {
+		m_dataFolder += wxFileName::GetPathSeparator();
+	}
+	return true;
+}
+
+int DialNeedleApp::OnRun(void) {
+	InitializeStubs(m_dataFolder);
+
+	// The dial is never shown, invalidations are passed to the hidden frame and ignored
+	wxFrame *host = new wxFrame(NULL, wxID_ANY, _T("Dial Needle"));
+
+	bool result = RunNeedleTest(host);
+
+	host->Destroy();
+	ReleaseStubs();
+	return result ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Value formatter test. Compares the formatted text with the expected text, in particular
+// values formatted in range after values (no data, or too large) passed to wxString::Format.
+// Exits non-zero if any differ.
+//
+// Usage: format_values
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "value_formatter.h"
+
+#include <wx/init.h>
+#include <cmath>
+#include <cstdio>
+
+static bool Check(ValueFormatter &formatter, double value, const wxString &expected) {
+	const wxString &text = formatter.Format(value);
+	bool passed = (text == expected);
+	printf("%s: %g formatted as \"%s\", expected \"%s\"\n", passed ? "Passed" : "Failed",
+		value, (const char *)text.mb_str(), (const char *)expected.mb_str());
+	return passed;
+}
+
+int main(int argc, char **argv) {
+	wxInitializer initializer;
+	if (!initializer.IsOk()) {
+		fprintf(stderr, "Unable to initialize wxWidgets\n");
+		return 1;
+	}
+
+	bool result = true;
+	ValueFormatter formatter;
+
+	formatter.SetFormat(_T("%.1f"));
+	formatter.SetUnit(_T("C"), _T("T="), _T(" C"));
+	result &= Check(formatter, 12.34, _T("T=12.3 C"));
+	result &= Check(formatter, -0.04, _T("T=0.0 C"));
+	// Out of range, then in range, which must not show what remains of the former
+	result &= Check(formatter, 1e13, _T("T=10000000000000.0 C"));
+	result &= Check(formatter, 12.34, _T("T=12.3 C"));
+
+	// No data, then data, with leading text
+	formatter.SetFormat(_T("Level %5.1f%%"));
+	formatter.SetUnit(_T("%"), wxEmptyString, wxEmptyString);
+	result &= Check(formatter, 42, _T("Level  42.0%"));
+	result &= Check(formatter, NAN, wxString::Format(_T("Level %5.1f%%"), NAN));
+	result &= Check(formatter, 7, _T("Level   7.0%"));
+
+	formatter.SetFormat(_T("%+06.2f"));
+	formatter.SetUnit(_T("V"), _T("("), _T(" V)"));
+	result &= Check(formatter, 3.14159, _T("(+03.14 V)"));
+	result &= Check(formatter, -1e15, _T("(") + wxString::Format(_T("%+06.2f"), -1e15) + _T(" V)"));
+	result &= Check(formatter, -3.14159, _T("(-03.14 V)"));
+
+	return result ? 0 : 1;
+}
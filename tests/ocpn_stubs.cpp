@@ -0,0 +1,103 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Stand-ins for the few OpenCPN functions and plugin globals used by the instruments,
+// so that the test and benchmark executables run without OpenCPN, eg. in a Linux container.
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "ocpn_stubs.h"
+#include "instrument.h"
+
+#if wxCHECK_VERSION(3, 1, 6)
+#include <wx/bmpbndl.h>
+#endif
+
+// Otherwise defined by dashboard_pi.cpp
+wxFont *g_pFontTitle;
+wxFont *g_pFontData;
+wxFont *g_pFontLabel;
+wxFont *g_pFontSmall;
+PI_ColorScheme g_ColorScheme = PI_GLOBAL_COLOR_SCHEME_DAY;
+wxString iconFolder;
+
+// The dashboard colours of OpenCPN's day colour scheme
+struct StubColour {
+	const wxChar *name;
+	unsigned char red;
+	unsigned char green;
+	unsigned char blue;
+};
+
+static const StubColour stubColours[] = {
+	{ _T("DASHB"), 255, 255, 255 },
+	{ _T("DASHL"), 190, 190, 190 },
+	{ _T("DASHF"), 50, 50, 50 },
+	{ _T("DASHR"), 200, 0, 0 },
+	{ _T("DASHG"), 0, 200, 0 },
+	{ _T("DASHN"), 200, 120, 0 },
+	{ _T("DASH1"), 204, 204, 255 },
+	{ _T("DASH2"), 122, 131, 172 }
+};
+
+bool GetGlobalColor(wxString colorName, wxColour *pcolour) {
+	for (size_t i = 0; i < sizeof(stubColours) / sizeof(stubColours[0]); i++) {
+		if (colorName == stubColours[i].name) {
+			pcolour->Set(stubColours[i].red, stubColours[i].green, stubColours[i].blue);
+			return true;
+		}
+	}
+	*pcolour = *wxBLACK;
+	return false;
+}
+
+// Older versions of wxWidgets cannot render SVG, the icons are then left blank
+wxBitmap GetBitmapFromSVGFile(wxString filename, unsigned int width, unsigned int height) {
+#if wxCHECK_VERSION(3, 1, 6)
+	wxBitmapBundle bundle = wxBitmapBundle::FromSVGFile(filename, wxSize(width, height));
+	if (bundle.IsOk()) {
+		return bundle.GetBitmap(wxSize(width, height));
+	}
+#endif
+	wxBitmap bitmap(width, height);
+	wxMemoryDC mdc(bitmap);
+	mdc.SetBackground(*wxWHITE_BRUSH);
+	mdc.Clear();
+	mdc.SelectObject(wxNullBitmap);
+	return bitmap;
+}
+
+void InitializeStubs(const wxString &dataFolder) {
+	g_pFontTitle = new wxFont(10, wxFONTFAMILY_SWISS, wxFONTSTYLE_ITALIC, wxFONTWEIGHT_NORMAL);
+	g_pFontData = new wxFont(14, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+	g_pFontLabel = new wxFont(8, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+	g_pFontSmall = new wxFont(8, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+	iconFolder = dataFolder;
+	UpdatePalette();
+}
+
+void ReleaseStubs(void) {
+	delete g_pFontTitle;
+	delete g_pFontData;
+	delete g_pFontLabel;
+	delete g_pFontSmall;
+}
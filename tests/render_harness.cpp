@@ -0,0 +1,579 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Offscreen render harness. Renders every type of instrument into a bitmap at several
+// sizes, with a script of values. Each frame is saved as a PNG (eg. for golden image
+// comparisons) and the paint times are written to timings.csv. With --phases, instead
+// times each of the dial's draw phases, for every marker and label option, written to phases.json.
+// With --composite, instead times dashboards of increasing size painted one window per instrument
+// and composited into a single back-buffer, written to composite.csv. With --static-layer, instead
+// times a layout of eight dials painted with the cached static layer and with every phase redrawn
+// on each paint, as before it was cached, written to static_layer.csv.
+//
+// Usage: render_harness [--phases | --composite | --static-layer] <output folder> <data folder>
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include "ocpn_stubs.h"
+#include "instrument.h"
+#include "dial.h"
+#include "speedometer.h"
+#include "rudder_angle.h"
+
+#include <wx/filename.h>
+#include <wx/ffile.h>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Number of times each frame is painted, the first paint (which builds any caches)
+// is reported separately from the average of the remainder
+#define RENDER_HARNESS_PAINTS 20
+
+typedef enum {
+	HARNESS_DIAL,
+	HARNESS_SPEEDOMETER,
+	HARNESS_RUDDER_ANGLE,
+	HARNESS_SINGLE,
+	HARNESS_BLOCK,
+	HARNESS_GAUGE,
+	HARNESS_COUNT
+} HarnessInstrument;
+
+struct HarnessSpec {
+	const wxChar *name;
+	DASH_CAP cap;
+	double minimum;
+	double maximum;
+	const wxChar *unit;
+};
+
+static const HarnessSpec harnessSpecs[HARNESS_COUNT] = {
+	{ _T("Dial"), OCPN_DBP_STC_MAIN_ENGINE_WATER, 0, 120, _T("C") },
+	{ _T("Speedometer"), OCPN_DBP_STC_MAIN_ENGINE_RPM, 0, 6000, _T("RPM") },
+	{ _T("RudderAngle"), OCPN_DBP_STC_RSA, -40, 40, _T("\u00B0") },
+	{ _T("Single"), OCPN_DBP_STC_MAIN_ENGINE_HOURS, 0, 9000, _T("Hrs") },
+	{ _T("Block"), OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, 0, 100, _T("Level") },
+	{ _T("Gauge"), OCPN_DBP_STC_TANK_LEVEL_WATER_GAUGE_01, 0, 100, _T("Level") }
+};
+
+// Instrument widths, the height is whatever the instrument requires for that width
+static const int harnessWidths[] = { 100, 150, 300 };
+
+// The script of values, as a fraction of each instrument's range, NaN being no data
+static const double harnessFractions[] = { 0.05, 0.5, 0.95, NAN };
+
+// Configured as they are by the dashboard, see DashboardWindow::SetInstrumentList
+static DashboardInstrument *CreateHarnessInstrument(int type, wxWindow *parent) {
+	const HarnessSpec &spec = harnessSpecs[type];
+	DashboardInstrument_Dial *dial = NULL;
+	switch (type) {
+		case HARNESS_DIAL:
+			dial = new DashboardInstrument_Dial(parent, wxID_ANY, spec.name, spec.cap, 225, 270, (int)spec.minimum, (int)spec.maximum);
+			dial->SetOptionLabel(20, DIAL_LABEL_HORIZONTAL);
+			dial->SetOptionMarker(10, DIAL_MARKER_SIMPLE, 1);
+			dial->SetOptionMainValue(_T("%.1f"), DIAL_POSITION_INSIDE);
+			break;
+		case HARNESS_SPEEDOMETER:
+			dial = new DashboardInstrument_Speedometer(parent, wxID_ANY, spec.name, spec.cap, (int)spec.minimum, (int)spec.maximum);
+			dial->SetOptionLabel(1000, DIAL_LABEL_HORIZONTAL);
+			dial->SetOptionMarker(200, DIAL_MARKER_SIMPLE, 1);
+			dial->SetOptionExtraValue(OCPN_DBP_STC_MAIN_ENGINE_HOURS, _T("%.1f"), DIAL_POSITION_INSIDE);
+			break;
+		case HARNESS_RUDDER_ANGLE: {
+			dial = new DashboardInstrument_RudderAngle(parent, wxID_ANY, spec.name);
+			dial->SetOptionMarker(5, DIAL_MARKER_REDGREEN, 2);
+			wxString labels[] = {_T("40"), _T("30"), _T("20"), _T("10"), _T("0"), _T("10"), _T("20"), _T("30"), _T("40")};
+			dial->SetOptionLabel(10, DIAL_LABEL_HORIZONTAL, wxArrayString(9, labels));
+			break;
+		}
+		case HARNESS_SINGLE:
+			return new DashboardInstrument_Single(parent, wxID_ANY, spec.name, spec.cap, _T("%.1f"));
+		case HARNESS_BLOCK:
+			return new DashboardInstrument_Block(parent, wxID_ANY, spec.name, spec.cap, _T("%s"));
+		case HARNESS_GAUGE: {
+			DashboardInstrument_Gauge *gauge = new DashboardInstrument_Gauge(parent, wxID_ANY, spec.name, spec.cap);
+			gauge->SetOptionThresholds(20, 100);
+			return gauge;
+		}
+		default:
+			return NULL;
+	}
+	// Needles are drawn at their value, rather than animating towards it
+	dial->SetOptionNeedleDamping(0);
+	return dial;
+}
+
+// Renders each instrument, returns false if any of the frames could not be saved
+static bool RenderInstruments(wxWindow *host, const wxFileName &path, wxFFile &timings) {
+	bool result = true;
+	for (int type = 0; type < HARNESS_COUNT; type++) {
+		const HarnessSpec &spec = harnessSpecs[type];
+		DashboardInstrument *instrument = CreateHarnessInstrument(type, host);
+		if (instrument == NULL) {
+			continue;
+		}
+		instrument->SetComposited(true);
+
+		for (size_t i = 0; i < sizeof(harnessWidths) / sizeof(harnessWidths[0]); i++) {
+			wxSize size = instrument->GetSize(wxVERTICAL, wxSize(harnessWidths[i], 0));
+			instrument->SetSize(size);
+			wxBitmap frame(size.x, size.y);
+
+			for (size_t j = 0; j < sizeof(harnessFractions) / sizeof(harnessFractions[0]); j++) {
+				double value = spec.minimum + (harnessFractions[j] * (spec.maximum - spec.minimum));
+				instrument->SetData(spec.cap, value, spec.unit);
+
+				double first = 0;
+				double total = 0;
+				wxMemoryDC mdc(frame);
+				for (int paint = 0; paint < RENDER_HARNESS_PAINTS; paint++) {
+					wxStopWatch paintTimer;
+					{
+						wxGCDC dc(mdc);
+						instrument->Paint(dc, mdc, wxRect(size));
+					}
+					double elapsed = paintTimer.TimeInMicro().ToDouble() / 1000.0;
+					if (paint == 0) {
+						first = elapsed;
+					}
+					else {
+						total += elapsed;
+					}
+				}
+				mdc.SelectObject(wxNullBitmap);
+
+				wxString valueName = std::isnan(value) ? wxString(_T("nodata")) : wxString::Format(_T("%g"), value);
+				wxString fileName = wxString::Format(_T("%s_%dx%d_%s.png"), spec.name, size.x, size.y, valueName);
+				if (!frame.ConvertToImage().SaveFile(wxFileName(path.GetPath(), fileName).GetFullPath(), wxBITMAP_TYPE_PNG)) {
+					fprintf(stderr, "Unable to save %s\n", (const char *)fileName.mb_str());
+					result = false;
+				}
+
+				double average = total / (RENDER_HARNESS_PAINTS - 1);
+				timings.Write(wxString::Format(_T("%s,%d,%d,%s,%.3f,%.3f\n"), spec.name, size.x, size.y, valueName, first, average));
+				printf("%s, %dx%d, Value: %s, First: %.3f ms, Average: %.3f ms\n",
+					(const char *)wxString(spec.name).mb_str(),
+					size.x, size.y, (const char *)valueName.mb_str(), first, average);
+			}
+		}
+		instrument->Destroy();
+	}
+	return result;
+}
+
+// Renders the instruments
+static bool RunRenderHarness(wxWindow *host, const wxFileName &path) {
+	wxFFile timings(wxFileName(path.GetPath(), _T("timings.csv")).GetFullPath(), _T("w"));
+	if (!timings.IsOpened()) {
+		fprintf(stderr, "Unable to write timings to %s\n", (const char *)path.GetPath().mb_str());
+		return false;
+	}
+	timings.Write(_T("instrument,width,height,value,first_ms,average_ms\n"));
+
+	bool result = RenderInstruments(host, path, timings);
+	timings.Close();
+	return result;
+}
+
+// Names used in phases.json, indexed by DialDrawPhase, DialMarkerOption and DialLabelOption
+static const wxChar *phaseNames[DIAL_PHASE_COUNT] = {
+	_T("labels"), _T("frame"), _T("markers"), _T("background"), _T("warning"), _T("data"), _T("foreground")
+};
+
+static const DialMarkerOption benchmarkMarkers[] = {
+	DIAL_MARKER_NONE, DIAL_MARKER_SIMPLE, DIAL_MARKER_REDGREEN, DIAL_MARKER_REDGREENBAR,
+	DIAL_MARKER_WARNING_HIGH, DIAL_MARKER_WARNING_LOW, DIAL_MARKER_GREEN_MID
+};
+static const wxChar *markerNames[] = {
+	_T("none"), _T("simple"), _T("redgreen"), _T("redgreenbar"), _T("warning_high"), _T("warning_low"), _T("green_mid")
+};
+
+static const DialLabelOption benchmarkLabels[] = {
+	DIAL_LABEL_NONE, DIAL_LABEL_HORIZONTAL, DIAL_LABEL_ROTATED, DIAL_LABEL_FRACTIONS
+};
+static const wxChar *labelNames[] = {
+	_T("none"), _T("horizontal"), _T("rotated"), _T("fractions")
+};
+
+// Client widths, the height is whatever the dial requires for that width
+static const int benchmarkWidths[] = { 100, 200, 300, 400, 500, 600 };
+
+// Writes the timings of each phase, for every marker and label option and size
+static void BenchmarkPhases(DashboardInstrument_Dial *dial, wxFFile &results) {
+	bool first = true;
+	for (size_t m = 0; m < sizeof(benchmarkMarkers) / sizeof(benchmarkMarkers[0]); m++) {
+		for (size_t l = 0; l < sizeof(benchmarkLabels) / sizeof(benchmarkLabels[0]); l++) {
+			dial->SetOptionMarker(5, benchmarkMarkers[m], 1);
+			dial->SetOptionLabel(25, benchmarkLabels[l]);
+
+			for (size_t i = 0; i < sizeof(benchmarkWidths) / sizeof(benchmarkWidths[0]); i++) {
+				wxSize size = dial->GetSize(wxVERTICAL, wxSize(benchmarkWidths[i], 0));
+				dial->SetSize(size);
+				wxBitmap frame(size.x, size.y);
+				wxMemoryDC mdc(frame);
+				// Warnings expire, so they are reported again for each size
+				dial->SetData(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE, 0x0003, FAULT_STATUS_WORD);
+
+				for (int phase = 0; phase < DIAL_PHASE_COUNT; phase++) {
+					double firstPaint = 0;
+					double total = 0;
+					for (int paint = 0; paint < RENDER_HARNESS_PAINTS; paint++) {
+						wxGCDC dc(mdc);
+						wxStopWatch phaseTimer;
+						dial->DrawPhase(&dc, (DialDrawPhase)phase);
+						double elapsed = phaseTimer.TimeInMicro().ToDouble() / 1000.0;
+						if (paint == 0) {
+							firstPaint = elapsed;
+						}
+						else {
+							total += elapsed;
+						}
+					}
+					double average = total / (RENDER_HARNESS_PAINTS - 1);
+
+					results.Write(wxString::Format(_T("%s\n    {\"marker\": \"%s\", \"label\": \"%s\", \"width\": %d, \"height\": %d, \"phase\": \"%s\", \"first_ms\": %.4f, \"average_ms\": %.4f}"),
+						first ? _T("") : _T(","), markerNames[m], labelNames[l], size.x, size.y, phaseNames[phase], firstPaint, average));
+					first = false;
+				}
+				mdc.SelectObject(wxNullBitmap);
+			}
+		}
+	}
+}
+
+// Times each of the dial's draw phases
+static bool RunPhaseBenchmark(wxWindow *host, const wxFileName &path) {
+	wxString fileName = wxFileName(path.GetPath(), _T("phases.json")).GetFullPath();
+	wxFFile results(fileName, _T("w"));
+	if (!results.IsOpened()) {
+		fprintf(stderr, "Unable to write results to %s\n", (const char *)path.GetPath().mb_str());
+		return false;
+	}
+
+	// A tank level dial, whose range suits each of the label options, with both values and a warning shown
+	DashboardInstrument_Dial *dial = new DashboardInstrument_Dial(host, wxID_ANY, _T("Dial"), OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, 150, 240, 0, 100);
+	dial->SetComposited(true);
+	dial->SetOptionNeedleDamping(0);
+	dial->SetOptionMainValue(_T("%.0f"), DIAL_POSITION_INSIDE);
+	dial->SetOptionExtraValue(OCPN_DBP_STC_MAIN_ENGINE_HOURS, _T("%.1f"), DIAL_POSITION_BOTTOMLEFT);
+	dial->SetOptionWarningValue(OCPN_DBP_STC_MAIN_ENGINE_FAULT_ONE);
+	dial->SetData(OCPN_DBP_STC_TANK_LEVEL_FUEL_GAUGE_01, 60, _T("%"));
+	dial->SetData(OCPN_DBP_STC_MAIN_ENGINE_HOURS, 1234.5, _T("Hrs"));
+
+	results.Write(wxString::Format(_T("{\n  \"paints\": %d,\n  \"results\": ["), RENDER_HARNESS_PAINTS));
+	BenchmarkPhases(dial, results);
+	results.Write(_T("\n  ]\n}\n"));
+
+	bool result = !results.Error();
+	results.Close();
+	dial->Destroy();
+	printf("Results written to %s\n", (const char *)fileName.mb_str());
+	return result;
+}
+
+// Number of copies of every instrument in each dashboard compared by the composite benchmark
+static const int compositeCopies[] = { 1, 4, 16 };
+
+// Paints a frame of the dashboard, either as DashboardInstrument::OnPaint does for each instrument's window,
+// or as DashboardWindow::OnPaint does with a single back-buffer. In both cases the result is copied to the screen.
+static void PaintDashboard(bool composite, std::vector<DashboardInstrument *> &instruments,
+	std::vector<wxBitmap> &backBuffers, wxBitmap &screen) {
+	wxMemoryDC sdc(screen);
+	if (composite) {
+		wxMemoryDC mdc(backBuffers[0]);
+		{
+			wxGCDC dc(mdc);
+			dc.SetBackground(*wxBLACK_BRUSH);
+			dc.Clear();
+			for (size_t i = 0; i < instruments.size(); i++) {
+				wxRect cell = instruments[i]->GetRect();
+				dc.SetDeviceOrigin(cell.x, cell.y);
+				mdc.SetDeviceOrigin(cell.x, cell.y);
+				instruments[i]->Paint(dc, mdc, wxRect(cell.GetSize()));
+			}
+			dc.SetDeviceOrigin(0, 0);
+			mdc.SetDeviceOrigin(0, 0);
+		}
+		sdc.Blit(0, 0, screen.GetWidth(), screen.GetHeight(), &mdc, 0, 0);
+		mdc.SelectObject(wxNullBitmap);
+	}
+	else {
+		// The dashboard window's background, around any narrower instruments
+		sdc.SetBackground(*wxBLACK_BRUSH);
+		sdc.Clear();
+		for (size_t i = 0; i < instruments.size(); i++) {
+			wxRect cell = instruments[i]->GetRect();
+			wxMemoryDC mdc(backBuffers[i]);
+			{
+				wxGCDC dc(mdc);
+				instruments[i]->Paint(dc, mdc, wxRect(cell.GetSize()));
+			}
+			sdc.Blit(cell.x, cell.y, cell.width, cell.height, &mdc, 0, 0);
+			mdc.SelectObject(wxNullBitmap);
+		}
+	}
+	sdc.SelectObject(wxNullBitmap);
+}
+
+// Times painting a dashboard of every instrument, as a window per instrument and composited
+static bool RunCompositeBenchmark(wxWindow *host, const wxFileName &path) {
+	wxFFile timings(wxFileName(path.GetPath(), _T("composite.csv")).GetFullPath(), _T("w"));
+	if (!timings.IsOpened()) {
+		fprintf(stderr, "Unable to write timings to %s\n", (const char *)path.GetPath().mb_str());
+		return false;
+	}
+	timings.Write(_T("mode,instruments,width,height,first_ms,average_ms\n"));
+
+	bool result = true;
+	for (size_t c = 0; c < sizeof(compositeCopies) / sizeof(compositeCopies[0]); c++) {
+		// Stacked vertically, as in a docked dashboard
+		std::vector<DashboardInstrument *> instruments;
+		wxSize layout(DefaultWidth, 0);
+		for (int copy = 0; copy < compositeCopies[c]; copy++) {
+			for (int type = 0; type < HARNESS_COUNT; type++) {
+				const HarnessSpec &spec = harnessSpecs[type];
+				DashboardInstrument *instrument = CreateHarnessInstrument(type, host);
+				if (instrument == NULL) {
+					continue;
+				}
+				instrument->SetComposited(true);
+				wxSize size = instrument->GetSize(wxVERTICAL, wxSize(DefaultWidth, 0));
+				instrument->SetSize(0, layout.y, size.x, size.y);
+				instrument->SetData(spec.cap, (spec.minimum + spec.maximum) / 2, spec.unit);
+				instruments.push_back(instrument);
+				layout.x = wxMax(layout.x, size.x);
+				layout.y += size.y;
+			}
+		}
+		wxBitmap screen(layout.x, layout.y);
+
+		for (int composite = 0; composite < 2; composite++) {
+			const wxChar *mode = composite ? _T("composite") : _T("window");
+			std::vector<wxBitmap> backBuffers;
+			if (composite) {
+				backBuffers.push_back(wxBitmap(layout.x, layout.y));
+			}
+			else {
+				for (size_t i = 0; i < instruments.size(); i++) {
+					wxSize size = instruments[i]->GetRect().GetSize();
+					backBuffers.push_back(wxBitmap(size.x, size.y));
+				}
+			}
+
+			double first = 0;
+			double total = 0;
+			for (int paint = 0; paint < RENDER_HARNESS_PAINTS; paint++) {
+				wxStopWatch frameTimer;
+				PaintDashboard(composite != 0, instruments, backBuffers, screen);
+				double elapsed = frameTimer.TimeInMicro().ToDouble() / 1000.0;
+				if (paint == 0) {
+					first = elapsed;
+				}
+				else {
+					total += elapsed;
+				}
+			}
+
+			// Both modes should produce the same image
+			wxString fileName = wxString::Format(_T("%s_%d.png"), mode, (int)instruments.size());
+			if (!screen.ConvertToImage().SaveFile(wxFileName(path.GetPath(), fileName).GetFullPath(), wxBITMAP_TYPE_PNG)) {
+				fprintf(stderr, "Unable to save %s\n", (const char *)fileName.mb_str());
+				result = false;
+			}
+
+			double average = total / (RENDER_HARNESS_PAINTS - 1);
+			timings.Write(wxString::Format(_T("%s,%d,%d,%d,%.3f,%.3f\n"), mode, (int)instruments.size(), layout.x, layout.y, first, average));
+			printf("%s, Instruments: %d, %dx%d, First: %.3f ms, Average: %.3f ms\n",
+				(const char *)wxString(mode).mb_str(), (int)instruments.size(), layout.x, layout.y, first, average);
+		}
+
+		for (size_t i = 0; i < instruments.size(); i++) {
+			instruments[i]->Destroy();
+		}
+	}
+	timings.Close();
+	return result;
+}
+
+// Number of dials in the layout compared by the static layer benchmark
+#define STATIC_LAYER_DIALS 8
+
+// Client widths of the dials, the height is whatever the dial requires for that width
+static const int staticLayerWidths[] = { 150, 300 };
+
+// Times painting a layout of dials, with the static layer and redrawing every phase, as the dials did before it
+// was cached. The cached frame time also includes painting the title, which the phases do not.
+static bool RunStaticLayerBenchmark(wxWindow *host, const wxFileName &path) {
+	wxFFile timings(wxFileName(path.GetPath(), _T("static_layer.csv")).GetFullPath(), _T("w"));
+	if (!timings.IsOpened()) {
+		fprintf(stderr, "Unable to write timings to %s\n", (const char *)path.GetPath().mb_str());
+		return false;
+	}
+	timings.Write(_T("mode,dials,width,first_ms,average_ms\n"));
+
+	// The dial, speedometer and rudder angle in turn, each showing the middle of its range
+	std::vector<DashboardInstrument_Dial *> dials;
+	for (int i = 0; i < STATIC_LAYER_DIALS; i++) {
+		int type = HARNESS_DIAL + (i % (HARNESS_RUDDER_ANGLE + 1));
+		const HarnessSpec &spec = harnessSpecs[type];
+		DashboardInstrument_Dial *dial = (DashboardInstrument_Dial *)CreateHarnessInstrument(type, host);
+		dial->SetComposited(true);
+		dial->SetData(spec.cap, (spec.minimum + spec.maximum) / 2, spec.unit);
+		dials.push_back(dial);
+	}
+
+	for (size_t w = 0; w < sizeof(staticLayerWidths) / sizeof(staticLayerWidths[0]); w++) {
+		std::vector<wxBitmap> backBuffers;
+		for (size_t i = 0; i < dials.size(); i++) {
+			wxSize size = dials[i]->GetSize(wxVERTICAL, wxSize(staticLayerWidths[w], 0));
+			dials[i]->SetSize(size);
+			backBuffers.push_back(wxBitmap(size.x, size.y));
+		}
+
+		for (int cached = 0; cached < 2; cached++) {
+			const wxChar *mode = cached ? _T("cached") : _T("uncached");
+			double first = 0;
+			double total = 0;
+			for (int paint = 0; paint < RENDER_HARNESS_PAINTS; paint++) {
+				wxStopWatch frameTimer;
+				for (size_t i = 0; i < dials.size(); i++) {
+					wxMemoryDC mdc(backBuffers[i]);
+					{
+						wxGCDC dc(mdc);
+						if (cached) {
+							dials[i]->Paint(dc, mdc, wxRect(backBuffers[i].GetSize()));
+						}
+						else {
+							dc.SetBackground(g_Palette.background);
+							dc.Clear();
+							for (int phase = 0; phase < DIAL_PHASE_COUNT; phase++) {
+								dials[i]->DrawPhase(&dc, (DialDrawPhase)phase);
+							}
+						}
+					}
+					mdc.SelectObject(wxNullBitmap);
+				}
+				double elapsed = frameTimer.TimeInMicro().ToDouble() / 1000.0;
+				if (paint == 0) {
+					first = elapsed;
+				}
+				else {
+					total += elapsed;
+				}
+			}
+
+			double average = total / (RENDER_HARNESS_PAINTS - 1);
+			timings.Write(wxString::Format(_T("%s,%d,%d,%.3f,%.3f\n"), mode, (int)dials.size(), staticLayerWidths[w], first, average));
+			printf("%s, Dials: %d, Width: %d, First: %.3f ms, Average: %.3f ms\n",
+				(const char *)wxString(mode).mb_str(), (int)dials.size(), staticLayerWidths[w], first, average);
+		}
+	}
+
+	for (size_t i = 0; i < dials.size(); i++) {
+		dials[i]->Destroy();
+	}
+	bool result = !timings.Error();
+	timings.Close();
+	return result;
+}
+
+typedef enum {
+	HARNESS_MODE_RENDER,
+	HARNESS_MODE_PHASES,
+	HARNESS_MODE_COMPOSITE,
+	HARNESS_MODE_STATIC_LAYER
+} HarnessMode;
+
+class RenderHarnessApp : public wxApp {
+public:
+	bool OnInit(void);
+	int OnRun(void);
+
+private:
+	HarnessMode m_mode;
+	wxString m_outputFolder;
+	wxString m_dataFolder;
+};
+
+wxIMPLEMENT_APP(RenderHarnessApp);
+
+bool RenderHarnessApp::OnInit(void) {
+	m_mode = HARNESS_MODE_RENDER;
+	if (argc == 4) {
+		if (argv[1] == _T("--phases")) {
+			m_mode = HARNESS_MODE_PHASES;
+		}
+		else if (argv[1] == _T("--composite")) {
+			m_mode = HARNESS_MODE_COMPOSITE;
+		}
+		else if (argv[1] == _T("--static-layer")) {
+			m_mode = HARNESS_MODE_STATIC_LAYER;
+		}
+	}
+	if ((argc != 3) && (m_mode == HARNESS_MODE_RENDER)) {
+		fprintf(stderr, "Usage: render_harness [--phases | --composite | --static-layer] <output folder> <data folder>\n");
+		return false;
+	}
+	// Log to the console rather than to message boxes
+	delete wxLog::SetActiveTarget(new wxLogStderr());
+	m_outputFolder = argv[argc - 2];
+	m_dataFolder = argv[argc - 1];
+	if (!m_dataFolder.EndsWith(wxFileName::GetPathSeparator())) {
+		m_dataFolder += wxFileName::GetPathSeparator();
+	}
+	return true;
+}
+
+int RenderHarnessApp::OnRun(void) {
+	wxFileName path(m_outputFolder, wxEmptyString);
+	if (!path.DirExists() && !path.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+		fprintf(stderr, "Unable to create %s\n", (const char *)path.GetPath().mb_str());
+		return 1;
+	}
+
+	wxInitAllImageHandlers();
+	InitializeStubs(m_dataFolder);
+
+	// The instruments are never shown, invalidations are passed to the hidden frame and ignored
+	wxFrame *host = new wxFrame(NULL, wxID_ANY, _T("Render Harness"));
+
+	bool result;
+	switch (m_mode) {
+		case HARNESS_MODE_PHASES:
+			result = RunPhaseBenchmark(host, path);
+			break;
+		case HARNESS_MODE_COMPOSITE:
+			result = RunCompositeBenchmark(host, path);
+			break;
+		case HARNESS_MODE_STATIC_LAYER:
+			result = RunStaticLayerBenchmark(host, path);
+			break;
+		default:
+			result = RunRenderHarness(host, path);
+			break;
+	}
+
+	host->Destroy();
+	ReleaseStubs();
+	return result ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+//
+// This file is part of Engine Dashboard, a plugin for OpenCPN.
+// Author: Steven Adler
+//
+// Stand-in for OpenCPN's plugin API header, declaring only what the instruments use.
+// Found before the real header by the test executables, refer to ocpn_stubs.cpp.
+//
+// Please send bug reports to twocanplugin@hotmail.com or to the opencpn forum
+//
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _PLUGIN_H_
+#define _PLUGIN_H_
+
+#include <wx/wxprec.h>
+
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#define DECL_EXP
+
+typedef enum PI_ColorScheme {
+	PI_GLOBAL_COLOR_SCHEME_RGB,
+	PI_GLOBAL_COLOR_SCHEME_DAY,
+	PI_GLOBAL_COLOR_SCHEME_DUSK,
+	PI_GLOBAL_COLOR_SCHEME_NIGHT,
+	PI_N_COLOR_SCHEMES
+} PI_ColorScheme;
+
+extern DECL_EXP bool GetGlobalColor(wxString colorName, wxColour *pcolour);
+extern DECL_EXP wxBitmap GetBitmapFromSVGFile(wxString filename, unsigned int width, unsigned int height);
+
+#endif // _PLUGIN_H_